@@ -1,37 +1,10 @@
-#include <queue>                // for 'Q' as a min-heap
-#include <vector>               // for 'Q'
+#include <vector>
 #include "algorithm.h"
-#include <unordered_set>        // for the expanded list
 using namespace std;
 
 
-// expanded list done using a unordered_set to prevent duplicate states.
-unordered_set<string> expandedList;     
-
-
-///////////////////////////////////////////////////////////////////////////////////////////
-//
-//  Custom comparators.
-//  Used "https://www.geeksforgeeks.org/comparator-in-cpp/" for how to do comparator
-//      
-//      - Uniform Cost will compare using the g-cost
-//      - A* will compare using the f-cost (= gcost + hcost)
-//
-////////////////////////////////////////////////////////////////////////////////////////////
-
-// Custom comparator for the Uniform Cost 'Q' to maintain a min-heap. Uses gCost
-struct gCostComparator {
-    bool operator() (Puzzle &p1, Puzzle &p2) const {
-        return p1.getGCost() > p2.getGCost();
-    }
-};
-
-// Custom comparator for the A* 'Q' to maintain a min-heap. uses fCost.
-struct fCostComparator {
-    bool operator() (Puzzle &p1, Puzzle &p2) const {
-        return p1.getFCost() > p2.getFCost();
-    }
-};
+// Context used by uc_explist() and aStar_ExpandedList(), kept between calls so its memory is reused.
+SearchContext defaultContext;
 
 
 
@@ -50,96 +23,165 @@ void findMaxQLength(int qLength, int &maxQLength) {
 
 
 
-// Uniform Cost function to check 'Q' and 'expanded list' before adding an updated state. Uses a reference to puzzle object
-void updateUniformCostQ(Puzzle &updatedState, vector<Puzzle> &Q, int &numDeletions, int &numReexpand) {
+// Sets up the context for a new search. Counters go back to 0, the lists are emptied but keep their memory.
+SearchContext::SearchContext() {
+    reset();
+}
+
+void SearchContext::reset() {
+    pathLength = 0;
+    numOfStateExpansions = 0;
+    maxQLength = 0;
+    actualRunningTime = 0.0;
+    numOfDeletionsFromMiddleOfHeap = 0;
+    numOfLocalLoopsAvoided = 0;
+    numOfAttemptedNodeReExpansions = 0;
+    status = noSolutionFound;
+    suboptimalityBound = 1.0;
+    numOfGeneratedNodes = 0;
+    peakMemoryBytes = 0;
+
+    expandedList.clear();
+    nodeStore.clear();
+
+    // a 'Q' left over from an earlier search still points into the arena, and clear() reads
+    // those nodes, so every 'Q' is emptied before the arena's memory is reused
+    clearQ(ucHeapQ);
+    clearQ(ucBucketQ);
+    clearQ(aStarHeapQ);
+    clearQ(aStarBucketQ);
+    nodeArena.reset();
+}
+
+
+// Sets 'status' to unsolvable, and returns true, if the goal can't be reached from the start (see solvability.h)
+bool SearchContext::rejectUnsolvable(string const &initialState, string const &goalState) {
+
+    if(isSolvable(packBoard(initialState), packBoard(goalState))) {
+        return false;
+    }
+    status = unsolvable;
+    return true;
+}
+
+
+
+void SearchContext::getCounters(int& pathLength, int &numOfStateExpansions, int& maxQLength, float &actualRunningTime,
+                                int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided, int &numOfAttemptedNodeReExpansions) {
+    SearchMetrics metrics;
+    getMetrics(metrics);
+    metrics.getCounters(pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap,
+                        numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
+}
+
+
+void SearchContext::getMetrics(SearchMetrics &metrics) {
+    metrics.pathLength = pathLength;
+    metrics.numOfStateExpansions = numOfStateExpansions;
+    metrics.maxQLength = maxQLength;
+    metrics.actualRunningTime = actualRunningTime;
+    metrics.numOfDeletionsFromMiddleOfHeap = numOfDeletionsFromMiddleOfHeap;
+    metrics.numOfLocalLoopsAvoided = numOfLocalLoopsAvoided;
+    metrics.numOfAttemptedNodeReExpansions = numOfAttemptedNodeReExpansions;
+    metrics.numOfGeneratedNodes = numOfGeneratedNodes;
+    metrics.peakMemoryBytes = peakMemoryBytes;
+    metrics.suboptimalityBound = suboptimalityBound;
+}
+
+
+// Memory for the nodes of a Uniform Cost or A* search: the Puzzle objects, their node records, and 'Q' at its longest.
+// Nothing is freed during the search, so at the end this is the peak.
+size_t SearchContext::nodeMemory() {
+    return nodeArena.bytesUsed() + nodeStore.size() * sizeof(NodeRecord) + maxQLength * sizeof(Puzzle *);
+}
+
+
+
+// Uniform Cost function to check 'Q' and 'expanded list' before adding an updated state. Uses a pointer to the arena's puzzle object
+// 'parentNode' and 'move' are recorded in the node store if the state is put into 'Q', otherwise the puzzle is given back to the arena
+template <typename QType>
+void SearchContext::updateUniformCostQ(Puzzle *updatedState, int parentNode, moveDirection move, QType &Q) {
     
     // Check if this new state is in the expanded list (step 6)
-    if(expandedList.find(updatedState.getString()) == expandedList.end()) {
+    if(!expandedList.contains(updatedState->getState())) {
             
-        /* Check if the new state is already in 'Q' (step 7)
-        Have adapted syntax from:   https://stackoverflow.com/questions/42933943/how-to-use-lambda-for-stdfind-if
-        'find_if()' returns an iterator to the first element within 'Q' based on a given condition, or if not found returns 'end' iterator
-        [&updatedState] allows the lambda function to use this variable by reference.
-        the 'iterator' variable will be a pointer to the returned iterator - either Q.end() or a matching state   */
-        auto iterator = find_if(Q.begin(), Q.end(), [&updatedState](Puzzle& p) {
-            return p.getString() == updatedState.getString();
-        });
+        // Check if the new state is already in 'Q' (step 7). 'Q' keeps track of the slot of every state it holds.
+        int slot = Q.find(updatedState->getState());
         
 
-        // if 'iterator' points to Q.end() then this state is NOT already in 'Q' so can add it
-        if (iterator == Q.end()) { 
-            Q.push_back(updatedState);
-            push_heap(Q.begin(), Q.end(), gCostComparator());
+        // if the state is NOT already in 'Q' then can add it
+        if (slot == QType::NOT_IN_Q) { 
+            updatedState->setNode(nodeStore.addNode(parentNode, move));
+            Q.push(updatedState);
         } 
 
         // Otherwise if the state is already in 'Q' then need to check the lowest cost version.
         else {            
             // check the gCost to see which version of the state should be in 'Q'
-            if (iterator->getGCost() > updatedState.getGCost()) {
+            if (Q.at(slot)->getGCost() > updatedState->getGCost()) {
                 
-                // Dereference 'iterator' to replace with the lower-cost state
-                *iterator = updatedState;
-                
-                // Reorganise the heap after the update to rebalance the heap
-                make_heap(Q.begin(), Q.end(), gCostComparator());
+                // replace with the lower-cost state, and move it up the heap to its new place
+                updatedState->setNode(nodeStore.addNode(parentNode, move));
+                Q.decreaseKey(slot, updatedState);
                 
                 // haven't delted from heap to avoid extra cost, have instead replaced directly
-                numDeletions++;
+                numOfDeletionsFromMiddleOfHeap++;
+            }
+            else {
+                nodeArena.releaseLast();
             }
         }
     }
     
     else {
         // if IS in the expanded list then have tried to re-exapnd
-        numReexpand++;
+        numOfAttemptedNodeReExpansions++;
+        nodeArena.releaseLast();
     }
 }
 
 
 
-// A* Cost function to check 'Q' and 'expanded list' before adding an updated state. Uses a reference to puzzle object 
-void updateAStarQ(Puzzle &updatedState, vector<Puzzle> &Q, int &numDeletions, int &numReexpand) {
+// A* Cost function to check 'Q' and 'expanded list' before adding an updated state. Uses a pointer to the arena's puzzle object 
+// 'parentNode' and 'move' are recorded in the node store if the state is put into 'Q', otherwise the puzzle is given back to the arena
+template <typename QType>
+void SearchContext::updateAStarQ(Puzzle *updatedState, int parentNode, moveDirection move, QType &Q) {
     
     // Check if this new state is in the expanded list (step 6)
-    if(expandedList.find(updatedState.getString()) == expandedList.end()) {
+    if(!expandedList.contains(updatedState->getState())) {
             
-        
-        /* Check if the new state is already in 'Q' (step 7)
-        Have adapted syntax from:   https://stackoverflow.com/questions/42933943/how-to-use-lambda-for-stdfind-if
-        'find_if()' returns an iterator to the first element within 'Q' based on a given condition, or if not found returns 'end' iterator
-        [&updatedState] allows the lambda function to use this variable by reference.
-        the 'iterator' variable will be a pointer to the returned iterator - either Q.end() or a matching state   */
-        auto iterator = find_if(Q.begin(), Q.end(), [&updatedState](Puzzle& p) {
-            return p.getString() == updatedState.getString();
-        });
+        // Check if the new state is already in 'Q' (step 7). 'Q' keeps track of the slot of every state it holds.
+        int slot = Q.find(updatedState->getState());
         
 
-        // if 'iterator' points to Q.end() then this state is NOT already in 'Q' so can add it
-        if (iterator == Q.end()) { 
-            Q.push_back(updatedState);
-            push_heap(Q.begin(), Q.end(), fCostComparator()); // Add to heap
+        // if the state is NOT already in 'Q' then can add it
+        if (slot == QType::NOT_IN_Q) { 
+            updatedState->setNode(nodeStore.addNode(parentNode, move));
+            Q.push(updatedState);
         } 
 
         // Otherwise if the state is already in 'Q' then need to check the lowest cost version.
         else {            
             // check the fCost to see which version of the state should be in 'Q'
-            if (iterator->getFCost() > updatedState.getFCost()) {
-                
-                // Dereference 'iterator' to replace with the lower-cost state
-                *iterator = updatedState;
+            if (Q.at(slot)->getFCost() > updatedState->getFCost()) {
                 
-                // Reorganise the heap after the update
-                make_heap(Q.begin(), Q.end(), fCostComparator());
+                // replace with the lower-cost state, and move it up the heap to its new place
+                updatedState->setNode(nodeStore.addNode(parentNode, move));
+                Q.decreaseKey(slot, updatedState);
                 
                 // haven't delted from heap to avoid extra cost, have instead replaced directly
-                numDeletions++;
+                numOfDeletionsFromMiddleOfHeap++;
+            }
+            else {
+                nodeArena.releaseLast();
             }
         }
     }
     
     else {
         // if IS in the expanded list then have tried to re-exapnd
-        numReexpand++;
+        numOfAttemptedNodeReExpansions++;
+        nodeArena.releaseLast();
     }
 }
 
@@ -149,38 +191,36 @@ void updateAStarQ(Puzzle &updatedState, vector<Puzzle> &Q, int &numDeletions, in
 //
 //  Search Algorithm:  UC with Strict Expanded List
 //
+//  'Q' is passed in empty, and is either a UniformCostHeapQ or a UniformCostBucketQ
+//
 ////////////////////////////////////////////////////////////////////////////////////////////
-string uc_explist(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
-                    float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided, 
-                    int &numOfAttemptedNodeReExpansions) {
+template <typename QType>
+string SearchContext::ucSearch(QType &Q, string const initialState, string const goalState) {
 											 
    
     //cout << "------------------------------" << endl;
     //cout << "<<uc_explist>>" << endl;
     //cout << "------------------------------" << endl;
    
-    // initialising values
-    numOfDeletionsFromMiddleOfHeap = 0;          
-    numOfLocalLoopsAvoided = 0;                  
-    numOfAttemptedNodeReExpansions = 0;          
-    actualRunningTime = 0.0;
-    clock_t startTime;
+    // initialising values, and clearing the expanded list, node store and arena
+    reset();
+    SearchTime startTime;
     string path = "";
 
-    // Clear the global expanded list variable
-    expandedList.clear();
-    
-    // Create 'Q' as a vector, then convert to a min-heap using custom comparator of 'g-cost' value
-    vector<Puzzle> Q; 
-    make_heap(Q.begin(), Q.end(), gCostComparator());
-
-    // Create new Puzzle object with initial and goal states, add it to 'Q' vector, then update the heap
-    Puzzle puzzle(initialState, goalState);
-    Q.push_back(puzzle);         
-    push_heap(Q.begin(), Q.end(), gCostComparator());   
+    if(rejectUnsolvable(initialState, goalState)) {
+        return path;
+    }
+
+    // every Puzzle of the search points at the shared goal context
+    CanonicalProblem problem(initialState, goalState);
+
+    // Create new Puzzle object with initial and goal states, add it to 'Q'
+    Puzzle *puzzle = nodeArena.allocate(Puzzle(unpackBoard(problem.start), problem.goal));
+    puzzle->setNode(nodeStore.addRoot());
+    Q.push(puzzle);         
  	
 	
-    startTime = clock();
+    startTime = searchClock();
     
     // Start of the Uniform Cost algorithm loop
     while(true) {
@@ -196,12 +236,9 @@ string uc_explist(string const initialState, string const goalState, int& pathLe
             /////////////////////////////////////////////////////////////////////////
             // 
             //  STEP 2:  Extract the lowest path length from 'Q'
-            //           pop_heap() swaps lowest and highest cost objects in heap
             //
             ////////////////////////////////////////////////////////////////////////
-            pop_heap(Q.begin(), Q.end(), gCostComparator());
-            Puzzle currPuzzle = Q.back();                       
-            Q.pop_back();                                       
+            Puzzle *currPuzzle = Q.pop();                       
             
 
             //////////////////////////////////////////////////////////////////////////////////
@@ -209,8 +246,9 @@ string uc_explist(string const initialState, string const goalState, int& pathLe
             //  STEP 3:  If the current state matches the goal state then exit loop/algorithm
             //
             //////////////////////////////////////////////////////////////////////////////////
-            if(currPuzzle.goalMatch()) {
-                path = currPuzzle.getPath();
+            if(currPuzzle->goalMatch()) {
+                path = nodeStore.getPath(currPuzzle->getNode());
+                status = solutionFound;
                 break; 
             } 
         
@@ -231,9 +269,9 @@ string uc_explist(string const initialState, string const goalState, int& pathLe
                 //           the expanded list and continue.
                 //
                 //////////////////////////////////////////////////////////////////////////////
-                if(expandedList.find(currPuzzle.getString()) == expandedList.end()) {
+                if(!expandedList.contains(currPuzzle->getState())) {
                    
-                    expandedList.insert(currPuzzle.getString());     // add state to the expanded list
+                    expandedList.insert(currPuzzle->getState());     // add state to the expanded list
 
 
                     ///////////////////////////////////////////////////////////////////////////////
@@ -248,50 +286,26 @@ string uc_explist(string const initialState, string const goalState, int& pathLe
                     //
                     ////////////////////////////////////////////////////////////////////////////////
                     
-                    // Move blank tile up
-                    if(currPuzzle.canMoveUp()) {
-                        
-                        // Get the pointer to the updated Puzzle object 
-                        Puzzle *tempPuzzle = currPuzzle.moveUp();
-
-                        // Dereference the puzzle object and pass to function to check if can be added to 'Q'
-                        updateUniformCostQ(*tempPuzzle, Q, numOfDeletionsFromMiddleOfHeap, numOfAttemptedNodeReExpansions);
-                    }
-
+                    // Look up the legal moves for where the blank is, then generate each child
+                    const BlankMoves &moves = blankMoves[blankIndex(currPuzzle->getState())];
+                    int prevMove = nodeStore.getMove(currPuzzle->getNode());
 
-                    // Move blank tile right
-                    if(currPuzzle.canMoveRight()) {
-                        
-                        // Get the pointer to the updated Puzzle object 
-                        Puzzle *tempPuzzle = currPuzzle.moveRight();
-                        
-                        // Dereference the puzzle object, and pass to function to check if can be added to 'Q'
-                        updateUniformCostQ(*tempPuzzle, Q, numOfDeletionsFromMiddleOfHeap, numOfAttemptedNodeReExpansions);
-                    }
+                    for(int i = 0; i < moves.count; i++) {
 
+                        // moving the blank straight back gives the parent, which is already expanded (opposite moves are 2 apart)
+                        if(prevMove >= 0 && moves.move[i] == (prevMove + 2) % 4) {
+                            numOfLocalLoopsAvoided++;
+                            continue;
+                        }
 
-                    // Move blank tile down
-                    if(currPuzzle.canMoveDown()) {
-                        
-                        // Get the pointer to the updated Puzzle object 
-                        Puzzle *tempPuzzle = currPuzzle.moveDown();
+                        // Get the pointer to the updated Puzzle object (its h and f costs are updated by the move)
+                        Puzzle *tempPuzzle = currPuzzle->moveBlank(moves.cell[i], nodeArena);
+                        numOfGeneratedNodes++;
 
-                        // Dereference the puzzle object, and pass to function to check if can be added to 'Q'
-                        updateUniformCostQ(*tempPuzzle, Q, numOfDeletionsFromMiddleOfHeap, numOfAttemptedNodeReExpansions);
-                    }
-                    
-
-                    // Move blank tile left
-                    if(currPuzzle.canMoveLeft()) {
-                        
-                        // Get the pointer to the updated Puzzle object 
-                        Puzzle *tempPuzzle = currPuzzle.moveLeft();
-
-                        // Dereference the puzzle object, and pass to function to check if can be added to 'Q'
-                        updateUniformCostQ(*tempPuzzle, Q, numOfDeletionsFromMiddleOfHeap, numOfAttemptedNodeReExpansions);
+                        // Pass the puzzle object to function to check if can be added to 'Q'
+                        updateUniformCostQ(tempPuzzle, currPuzzle->getNode(), moves.move[i], Q);
                     }
 
-
                     // After any new nodes added to the 'Q', check if the maxsize has changed.
                     findMaxQLength(Q.size(), maxQLength);
                 
@@ -310,48 +324,58 @@ string uc_explist(string const initialState, string const goalState, int& pathLe
     
     
     // Final values to calculate.
-	actualRunningTime = ((float)(clock() - startTime)/CLOCKS_PER_SEC);
+	actualRunningTime = secondsSince(startTime);
     pathLength = path.length();
+    peakMemoryBytes = nodeMemory();
 	return path;	
 }
 
 
 
 
+// Runs Uniform Cost in this context, using the 'Q' type selected by 'frontier'
+string SearchContext::uniformCost(string const initialState, string const goalState, frontierType frontier) {
+
+    if(frontier == bucketFrontier) {
+        return ucSearch(emptyQ(ucBucketQ), initialState, goalState);
+    }
+    return ucSearch(emptyQ(ucHeapQ), initialState, goalState);
+}
+
+
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 //
 //  Search Algorithm:  A* with the Strict Expanded List
 //
+//  'Q' is passed in empty, and is either an AStarHeapQ or an AStarBucketQ
+//
 ////////////////////////////////////////////////////////////////////////////////////////////
-string aStar_ExpandedList(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
-                            float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided, 
-                            int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic){
+template <typename QType>
+string SearchContext::aStarSearch(QType &Q, string const initialState, string const goalState, heuristicFunction heuristic){
 											 
-    // initialise some values
-    numOfDeletionsFromMiddleOfHeap=0;
-    numOfLocalLoopsAvoided=0;
-    numOfAttemptedNodeReExpansions=0;
-    actualRunningTime=0.0;	
+    // initialise some values, and clear the expanded list, node store and arena
+    reset();
     string path = "";
-    clock_t startTime;
+    SearchTime startTime;
 
-	
-    // Clear the global expanded list variable
-    expandedList.clear();
+    if(rejectUnsolvable(initialState, goalState)) {
+        return path;
+    }
 
-    // Create 'Q' as a vector, then convert to a min-heap using custom comparator of 'g-cost' value
-    vector<Puzzle> Q; 
-    make_heap(Q.begin(), Q.end(), fCostComparator());
+    // every Puzzle of the search points at the shared goal context
+    CanonicalProblem problem(initialState, goalState, tablesFor(heuristic));
 
     // Create new Puzzle object with initial and goal states, calculate the heuristic value, then calculate f cost
-    Puzzle puzzle(initialState, goalState);
-    puzzle.updateHCost(heuristic);
-    puzzle.updateFCost();
+    Puzzle *puzzle = nodeArena.allocate(Puzzle(unpackBoard(problem.start), problem.goal));
+    puzzle->updateHCost(heuristic);
+    puzzle->updateFCost();
+    puzzle->setNode(nodeStore.addRoot());
   
-    // Add to 'Q', then update the heap
-    Q.push_back(puzzle);         
-    push_heap(Q.begin(), Q.end(), fCostComparator());   
-	startTime = clock();
+    // Add to 'Q'
+    Q.push(puzzle);         
+	startTime = searchClock();
 
     // start the A* Seach algorithm
 	while(true) {
@@ -366,12 +390,9 @@ string aStar_ExpandedList(string const initialState, string const goalState, int
             ///////////////////////////////////////////////////////////
             // 
             //  STEP 2:  Extract the lowest f-cost from 'Q'
-            //           pop_heap() swaps lowest and highest cost objects in heap
             //
             ////////////////////////////////////////////////////////////
-            pop_heap(Q.begin(), Q.end(), fCostComparator());     
-            Puzzle currPuzzle = Q.back();                       
-            Q.pop_back();                                       
+            Puzzle *currPuzzle = Q.pop();                       
 
 
             /////////////////////////////////////////////////////////////////////////////
@@ -379,8 +400,9 @@ string aStar_ExpandedList(string const initialState, string const goalState, int
             //  STEP 3:  If the current state matches the goal state then exit loop
             //
             //////////////////////////////////////////////////////////////////////////////
-            if(currPuzzle.goalMatch()) {
-                path = currPuzzle.getPath();
+            if(currPuzzle->goalMatch()) {
+                path = nodeStore.getPath(currPuzzle->getNode());
+                status = solutionFound;
                 break;                      
             } 
 
@@ -402,9 +424,9 @@ string aStar_ExpandedList(string const initialState, string const goalState, int
                 //
                 //////////////////////////////////////////////////////////////////////////////
 
-                if(expandedList.find(currPuzzle.getString()) == expandedList.end()) {
+                if(!expandedList.contains(currPuzzle->getState())) {
 
-                    expandedList.insert(currPuzzle.getString());     // add state to the expanded list
+                    expandedList.insert(currPuzzle->getState());     // add state to the expanded list
 
                     ///////////////////////////////////////////////////////////////////////////////
                     // 
@@ -418,55 +440,24 @@ string aStar_ExpandedList(string const initialState, string const goalState, int
                     //
                     ////////////////////////////////////////////////////////////////////////////////
 
-                    // Move blank tile up
-                    if(currPuzzle.canMoveUp()) {
-                        
-                        // Get the pointer to the updated Puzzle object 
-                        Puzzle *tempPuzzle = currPuzzle.moveUp();
-                        tempPuzzle->updateHCost(heuristic);
-                        tempPuzzle->updateFCost();
-
-                        // Dereference the puzzle object, and pass to function to check if can be added to 'Q'
-                        updateAStarQ(*tempPuzzle, Q, numOfDeletionsFromMiddleOfHeap, numOfAttemptedNodeReExpansions);
-                    }
+                    // Look up the legal moves for where the blank is, then generate each child
+                    const BlankMoves &moves = blankMoves[blankIndex(currPuzzle->getState())];
+                    int prevMove = nodeStore.getMove(currPuzzle->getNode());
 
+                    for(int i = 0; i < moves.count; i++) {
 
-                    // Move blank tile right
-                    if(currPuzzle.canMoveRight()) {
-                        
-                        // Get the pointer to the updated Puzzle object 
-                        Puzzle *tempPuzzle = currPuzzle.moveRight();
-                        tempPuzzle->updateHCost(heuristic);
-                        tempPuzzle->updateFCost();
-                        
-                        // Dereference the puzzle object, and pass to function to check if can be added to 'Q'
-                        updateAStarQ(*tempPuzzle, Q, numOfDeletionsFromMiddleOfHeap, numOfAttemptedNodeReExpansions);
-                    }
-
-
-                    // Move blank tile down
-                    if(currPuzzle.canMoveDown()) {
-                        
-                        // Get the pointer to the updated Puzzle object 
-                        Puzzle *tempPuzzle = currPuzzle.moveDown();
-                        tempPuzzle->updateHCost(heuristic);
-                        tempPuzzle->updateFCost();
-
-                        // Dereference the puzzle object, and pass to function to check if can be added to 'Q'
-                        updateAStarQ(*tempPuzzle, Q, numOfDeletionsFromMiddleOfHeap, numOfAttemptedNodeReExpansions);
-                    }
-                    
+                        // moving the blank straight back gives the parent, which is already expanded (opposite moves are 2 apart)
+                        if(prevMove >= 0 && moves.move[i] == (prevMove + 2) % 4) {
+                            numOfLocalLoopsAvoided++;
+                            continue;
+                        }
 
-                    // Move blank tile left
-                    if(currPuzzle.canMoveLeft()) {
-                        
-                        // Get the pointer to the updated Puzzle object 
-                        Puzzle *tempPuzzle = currPuzzle.moveLeft();
-                        tempPuzzle->updateHCost(heuristic);
-                        tempPuzzle->updateFCost();
+                        // Get the pointer to the updated Puzzle object (its h and f costs are updated by the move)
+                        Puzzle *tempPuzzle = currPuzzle->moveBlank(moves.cell[i], nodeArena);
+                        numOfGeneratedNodes++;
 
-                        // Dereference the puzzle object, and pass to function to check if can be added to 'Q'
-                        updateAStarQ(*tempPuzzle, Q, numOfDeletionsFromMiddleOfHeap, numOfAttemptedNodeReExpansions);
+                        // Pass the puzzle object to function to check if can be added to 'Q'
+                        updateAStarQ(tempPuzzle, currPuzzle->getNode(), moves.move[i], Q);
                     }
 
                     // After any new nodes added to the 'Q', check if the maxsize has changed.
@@ -486,8 +477,51 @@ string aStar_ExpandedList(string const initialState, string const goalState, int
 
 
     // final values to calculate
-	actualRunningTime = ((float)(clock() - startTime)/CLOCKS_PER_SEC);
+	actualRunningTime = secondsSince(startTime);
 	pathLength = path.length();
+    peakMemoryBytes = nodeMemory();
 	return path;		
 }
 
+
+
+// Runs A* in this context, using the 'Q' type selected by 'frontier'
+string SearchContext::aStar(string const initialState, string const goalState, heuristicFunction heuristic, frontierType frontier) {
+
+    if(frontier == bucketFrontier) {
+        return aStarSearch(emptyQ(aStarBucketQ), initialState, goalState, heuristic);
+    }
+    return aStarSearch(emptyQ(aStarHeapQ), initialState, goalState, heuristic);
+}
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Original interface, runs the search in the default context and copies out the counters
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+string uc_explist(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                    float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided, 
+                    int &numOfAttemptedNodeReExpansions, frontierType frontier) {
+
+    string path = defaultContext.uniformCost(initialState, goalState, frontier);
+
+    defaultContext.getCounters(pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap,
+                               numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
+    return path;
+}
+
+
+
+string aStar_ExpandedList(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                            float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided, 
+                            int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic, frontierType frontier){
+
+    string path = defaultContext.aStar(initialState, goalState, heuristic, frontier);
+
+    defaultContext.getCounters(pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap,
+                               numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
+    return path;
+}
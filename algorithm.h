@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "puzzle.h" //optional only, may be removed
+#include "search_context.h"
 
 
 /////////////////////////////////////////////////////
@@ -19,11 +20,31 @@
 
 string uc_explist(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
                     float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided, 
-                    int &numOfAttemptedNodeReExpansions);
+                    int &numOfAttemptedNodeReExpansions, frontierType frontier = heapFrontier);
 
 
 string aStar_ExpandedList(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
                             float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided, 
-                            int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic);
+                            int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic, frontierType frontier = heapFrontier);
+
+
+string uc_bidirectional(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                    float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided, 
+                    int &numOfAttemptedNodeReExpansions);
+
+
+string astar_weighted(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                    float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                    int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic, float weight, float &suboptimalityBound);
+
+
+string astar_anytime(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                    float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                    int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic, float initialWeight, float timeBudget,
+                    int expansionBudget, float &suboptimalityBound, anytimeReport report = NULL);
+
+
+// Context the functions above run in
+extern SearchContext defaultContext;
 
 #endif
\ No newline at end of file
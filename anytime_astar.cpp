@@ -0,0 +1,382 @@
+#include <climits>
+#include "algorithm.h"
+
+using namespace std;
+
+
+const int AnytimeSearch::NOT_SEEN;
+
+// weight taken off after each ARA* pass
+static const float WEIGHT_STEP = 0.5;
+
+// the blank's move in each direction (U, R, D, L), used to step back along the path
+static const int moveOffset[4] = {-BOARD_DIM, 1, BOARD_DIM, -1};
+
+
+AnytimeSearch::AnytimeSearch()
+    : gCost(NUM_PERMUTATIONS, NOT_SEEN), hCost(NUM_PERMUTATIONS, 0), hCode(NUM_PERMUTATIONS, 0), parentMove(NUM_PERMUTATIONS, 0),
+      inIncons(NUM_PERMUTATIONS, false), goalState(0), weight(WEIGHT_SCALE), numOfStateExpansions(0), maxQLength(0),
+      numOfDecreaseKeys(0), numOfReopened(0), numOfGeneratedNodes(0), suboptimalityBound(0) {}
+
+
+// Forgets the last search, only resetting the ranks it touched
+void AnytimeSearch::clear() {
+
+    for(size_t i = 0; i < seen.size(); i++) {
+        gCost[seen[i]] = NOT_SEEN;
+    }
+    for(size_t i = 0; i < incons.size(); i++) {
+        inIncons[rankState(incons[i])] = false;
+    }
+    seen.clear();
+    incons.clear();
+    closed.clear();
+    Q.clear();
+    nodeArena.reset();
+
+    numOfStateExpansions = 0;
+    maxQLength = 0;
+    numOfDecreaseKeys = 0;
+    numOfReopened = 0;
+    numOfGeneratedNodes = 0;
+    suboptimalityBound = 0;
+}
+
+
+// Puts 'state' into 'Q' with g-cost 'g', or lowers its key if it is already there
+void AnytimeSearch::push(PackedState state, int g) {
+
+    AnytimeNode node;
+    node.state = state;
+    node.g = g;
+    node.key = WEIGHT_SCALE * g + weight * hCost[rankState(state)];
+
+    AnytimeNode *stored = nodeArena.allocate(node);
+    int slot = Q.find(state);
+
+    if(slot == AnytimeQ::NOT_IN_Q) {
+        Q.push(stored);
+        if(Q.size() > maxQLength) {
+            maxQLength = Q.size();
+        }
+    }
+    else {
+        Q.decreaseKey(slot, stored);
+        numOfDecreaseKeys++;
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      One pass of weighted A* (ImprovePath in the ARA* paper). Expands
+//      until the goal's key is no more than the lowest key in 'Q', so
+//      the goal's g-cost is within 'weight' of optimal. A board reached
+//      more cheaply after it was expanded in this pass is not expanded
+//      again now, it goes on INCONS for the next pass.
+//
+//      Returns false if the time or expansion budget ran out first.
+//
+///////////////////////////////////////////////////////////////////////////////
+bool AnytimeSearch::improvePath(const GoalContext &goal, heuristicFunction heuristic, SearchTime startTime, float timeBudget,
+                                int expansionBudget) {
+
+    int goalRank = rankState(goalState);
+
+    while(!Q.empty()) {
+
+        if(gCost[goalRank] != NOT_SEEN && WEIGHT_SCALE * gCost[goalRank] <= Q.at(0)->key) {
+            break;
+        }
+
+        // the clock is only read every 256 expansions
+        if(expansionBudget > 0 && numOfStateExpansions >= expansionBudget) {
+            return false;
+        }
+        if(timeBudget > 0 && (numOfStateExpansions & 255) == 0
+           && secondsSince(startTime) >= timeBudget) {
+            return false;
+        }
+
+        AnytimeNode *current = Q.pop();
+        PackedState state = current->state;
+        int g = current->g;
+        int h = hCost[rankState(state)];
+        HeuristicCode code = hCode[rankState(state)];
+
+        closed.insert(state);
+        numOfStateExpansions++;
+
+        int blank = blankIndex(state);
+        const BlankMoves &moves = blankMoves[blank];
+
+        for(int i = 0; i < moves.count; i++) {
+
+            int cell = moves.cell[i];
+            int tile = tileAt(state, cell);
+            PackedState child = slideBlank(state, cell);
+            int rank = rankState(child);
+            numOfGeneratedNodes++;
+
+            if(gCost[rank] == NOT_SEEN) {
+                hCode[rank] = code;
+                hCost[rank] = h + heuristicDelta(child, tile, cell, blank, hCode[rank], heuristic, goal);
+                seen.push_back(rank);
+            }
+            else if(gCost[rank] <= g + 1) {
+                continue;
+            }
+
+            gCost[rank] = g + 1;
+            parentMove[rank] = moves.move[i];
+
+            if(!closed.contains(child)) {
+                push(child, g + 1);
+            }
+            else if(!inIncons[rank]) {
+                incons.push_back(child);
+                inIncons[rank] = true;
+                numOfReopened++;
+            }
+        }
+    }
+    return true;
+}
+
+
+// Sets up the next pass with the new weight: INCONS goes back into 'Q', every key is worked out again
+// and nothing counts as expanded any more
+void AnytimeSearch::nextPass() {
+
+    vector<PackedState> open(incons);
+    for(int i = 0; i < Q.size(); i++) {
+        if(!inIncons[rankState(Q.at(i)->state)]) {
+            open.push_back(Q.at(i)->state);
+        }
+    }
+
+    for(size_t i = 0; i < incons.size(); i++) {
+        inIncons[rankState(incons[i])] = false;
+    }
+    incons.clear();
+    closed.clear();
+    Q.clear();
+
+    for(size_t i = 0; i < open.size(); i++) {
+        push(open[i], gCost[rankState(open[i])]);
+    }
+}
+
+
+// Every board that could still lead to a shorter path is in 'Q' or INCONS, and none of them can do better
+// than its g + h, so g(goal) over the lowest g + h bounds how far from optimal the path is
+float AnytimeSearch::provedBound() {
+
+    int goalCost = gCost[rankState(goalState)];
+    int lowest = INT_MAX;
+
+    for(int i = 0; i < Q.size(); i++) {
+        int rank = rankState(Q.at(i)->state);
+        if(gCost[rank] + hCost[rank] < lowest) {
+            lowest = gCost[rank] + hCost[rank];
+        }
+    }
+    for(size_t i = 0; i < incons.size(); i++) {
+        int rank = rankState(incons[i]);
+        if(gCost[rank] + hCost[rank] < lowest) {
+            lowest = gCost[rank] + hCost[rank];
+        }
+    }
+
+    float bound = (float)weight / WEIGHT_SCALE;
+    if(lowest >= goalCost) {
+        return 1.0;
+    }
+    if(lowest > 0 && (float)goalCost / lowest < bound) {
+        bound = (float)goalCost / lowest;
+    }
+    return bound;
+}
+
+
+// Follows the parent moves back from the goal, stepping the blank the opposite way each time
+string AnytimeSearch::getPath(PackedState start) {
+
+    string path = "";
+    PackedState state = goalState;
+
+    while(state != start) {
+        int move = parentMove[rankState(state)];
+        path += moveLetters[move];
+        state = slideBlank(state, blankIndex(state) - moveOffset[move]);
+    }
+
+    return string(path.rbegin(), path.rend());
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Runs passes with the weight going from 'initialWeight' down by
+//      'weightStep' (or straight to the proved bound if that is lower)
+//      until a pass ends with a bound of 1, or the budget runs out. A
+//      weightStep of 0 is plain weighted A*, a single pass.
+//
+//      'timeBudget' is in seconds, and it and 'expansionBudget' are
+//      ignored if 0. 'report' (if not NULL) is called after every pass
+//      that found a better path.
+//
+///////////////////////////////////////////////////////////////////////////////
+string AnytimeSearch::search(PackedState start, const GoalContext &goal, heuristicFunction heuristic, float initialWeight,
+                             float weightStep, float timeBudget, int expansionBudget, anytimeReport report) {
+
+    clear();
+    SearchTime startTime = searchClock();
+    string path = "";
+
+    goalState = goal.getGoalState();
+    weight = (int)(initialWeight * WEIGHT_SCALE + 0.5);
+    if(weight < WEIGHT_SCALE) {
+        weight = WEIGHT_SCALE;
+    }
+    int step = (int)(weightStep * WEIGHT_SCALE + 0.5);
+
+    int rank = rankState(start);
+    gCost[rank] = 0;
+    hCost[rank] = heuristicValue(start, heuristic, goal);
+    hCode[rank] = heuristicCode(start, heuristic, goal);
+    seen.push_back(rank);
+    push(start, 0);
+
+    int bestLength = INT_MAX;
+
+    while(true) {
+
+        bool finished = improvePath(goal, heuristic, startTime, timeBudget, expansionBudget);
+        int goalCost = gCost[rankState(goalState)];
+
+        if(goalCost != NOT_SEEN && finished) {
+            suboptimalityBound = provedBound();
+
+            if(goalCost < bestLength) {
+                bestLength = goalCost;
+                path = getPath(start);
+                if(report != NULL) {
+                    report(path, suboptimalityBound);
+                }
+            }
+        }
+
+        // done: out of budget, nothing left to search, optimal, or a single weighted A* pass
+        if(!finished || Q.empty() || suboptimalityBound <= 1.0 || step <= 0 || weight == WEIGHT_SCALE) {
+            break;
+        }
+
+        int next = weight - step;
+        if(suboptimalityBound * WEIGHT_SCALE < next) {
+            next = (int)(suboptimalityBound * WEIGHT_SCALE);
+        }
+        weight = (next < WEIGHT_SCALE) ? WEIGHT_SCALE : next;
+        nextPass();
+    }
+
+    return path;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Runs weighted A* or ARA* in this context. The counters are mapped onto the original
+//  ones: decrease-keys count as deletions from the middle of the heap, and boards put on
+//  INCONS (reached more cheaply after being expanded) as attempted re-expansions.
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+string SearchContext::anytimeSearch(string const initialState, string const goalState, heuristicFunction heuristic,
+                                    float initialWeight, float weightStep, float timeBudget, int expansionBudget,
+                                    anytimeReport report) {
+
+    reset();
+    SearchTime startTime = searchClock();
+    string path = "";
+
+    if(rejectUnsolvable(initialState, goalState)) {
+        suboptimalityBound = 0;         // there is no path to bound
+        return path;
+    }
+
+    if(!anytime) {
+        anytime.reset(new AnytimeSearch());
+    }
+
+    CanonicalProblem problem(initialState, goalState, tablesFor(heuristic));
+    path = anytime->search(problem.start, problem.goal, heuristic, initialWeight, weightStep, timeBudget, expansionBudget, report);
+
+    // a path of length 0 is still a solution when the start is the goal
+    if(anytime->suboptimalityBound > 0) {
+        status = solutionFound;
+    }
+    suboptimalityBound = anytime->suboptimalityBound;
+    numOfStateExpansions = anytime->numOfStateExpansions;
+    maxQLength = anytime->maxQLength;
+    numOfDeletionsFromMiddleOfHeap = anytime->numOfDecreaseKeys;
+    numOfAttemptedNodeReExpansions = anytime->numOfReopened;
+    numOfGeneratedNodes = anytime->numOfGeneratedNodes;
+    peakMemoryBytes = anytime->bytesUsed();
+
+    actualRunningTime = secondsSince(startTime);
+    pathLength = path.length();
+    return path;
+}
+
+
+// Weighted A*: a single pass with f = g + weight.h, the path is at most 'weight' times optimal
+string SearchContext::weightedAStar(string const initialState, string const goalState, heuristicFunction heuristic, float weight) {
+    return anytimeSearch(initialState, goalState, heuristic, weight, 0, 0, 0, NULL);
+}
+
+
+// ARA*: starts at 'initialWeight' and improves the path until it is optimal or the budget runs out
+// ('timeBudget' in seconds, either budget 0 for no limit)
+string SearchContext::anytimeAStar(string const initialState, string const goalState, heuristicFunction heuristic,
+                                   float initialWeight, float timeBudget, int expansionBudget, anytimeReport report) {
+    return anytimeSearch(initialState, goalState, heuristic, initialWeight, WEIGHT_STEP, timeBudget, expansionBudget, report);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Same interface as uc_explist(), runs in the default context. 'suboptimalityBound' is
+//  set to how far from optimal the path can be (1 = optimal).
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+string astar_weighted(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                    float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                    int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic, float weight, float &suboptimalityBound) {
+
+    string path = defaultContext.weightedAStar(initialState, goalState, heuristic, weight);
+
+    defaultContext.getCounters(pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap,
+                               numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
+    suboptimalityBound = defaultContext.suboptimalityBound;
+    return path;
+}
+
+
+string astar_anytime(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                    float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                    int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic, float initialWeight, float timeBudget,
+                    int expansionBudget, float &suboptimalityBound, anytimeReport report) {
+
+    string path = defaultContext.anytimeAStar(initialState, goalState, heuristic, initialWeight, timeBudget, expansionBudget, report);
+
+    defaultContext.getCounters(pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap,
+                               numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
+    suboptimalityBound = defaultContext.suboptimalityBound;
+    return path;
+}
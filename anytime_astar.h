@@ -0,0 +1,110 @@
+#ifndef __ANYTIME_ASTAR_H__
+#define __ANYTIME_ASTAR_H__
+
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "closed_list.h"
+#include "goal_context.h"
+#include "heuristic.h"
+#include "indexed_heap.h"
+#include "node_arena.h"
+#include "search_clock.h"
+
+using namespace std;
+
+
+const int WEIGHT_SCALE = 100;          // weights are kept in whole hundredths, so f = 100g + 100w.h stays an integer
+
+
+// Called by the anytime search with each better path found, and the suboptimality bound proved for it
+typedef void (*anytimeReport)(string const &path, float bound);
+
+
+// A board in 'Q' with its key (WEIGHT_SCALE * g + weight * h)
+struct AnytimeNode {
+    PackedState state;
+    int g;
+    int key;
+
+    PackedState getState() {
+        return state;
+    }
+};
+
+// Lowest key first, the deeper node on a tie
+struct anytimeKeyComparator {
+    bool operator() (AnytimeNode *n1, AnytimeNode *n2) const {
+        return n1->key > n2->key || (n1->key == n2->key && n1->g < n2->g);
+    }
+};
+
+typedef IndexedHeap<AnytimeNode *, anytimeKeyComparator> AnytimeQ;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Weighted A* and ARA* (anytime repairing A*).
+//
+//  Weighted A* orders 'Q' on f = g + w.h. With w > 1 it goes much more directly to the goal,
+//  and the path it finds is at most w times the optimal length.
+//
+//  ARA* runs weighted A* with a falling weight, reusing the work already done: boards whose
+//  g-cost drops after they were expanded (in this pass) are kept in an INCONS list and put
+//  back into 'Q' for the next pass, instead of starting again. After each pass the path
+//  is at most  g(goal) / min(g + h over 'Q' and INCONS)  times the optimal length, which is
+//  often well under w. It stops when the bound reaches 1 (optimal) or the budget runs out.
+//
+//  Everything is indexed by the permutation rank and kept between searches.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class AnytimeSearch {
+
+private:
+    static const int NOT_SEEN = -1;
+
+    vector<int> gCost;                  // best g-cost found for each rank, NOT_SEEN if not generated
+    vector<unsigned char> hCost;        // heuristic of each rank, once generated
+    vector<HeuristicCode> hCode;        // heuristic code of each rank, to work out its children's hCost from
+    vector<unsigned char> parentMove;   // move that reached each rank with its g-cost
+    vector<int> seen;                   // ranks generated, to reset gCost after the search
+
+    ClosedList closed;                  // expanded in the current pass
+    vector<PackedState> incons;         // expanded in this pass, then reached more cheaply
+    vector<bool> inIncons;              // by rank
+
+    AnytimeQ Q;
+    NodeArena<AnytimeNode> nodeArena;
+
+    PackedState goalState;
+    int weight;                         // current w, in WEIGHT_SCALE units
+
+    void clear();
+    void push(PackedState state, int g);
+    bool improvePath(const GoalContext &goal, heuristicFunction heuristic, SearchTime startTime, float timeBudget, int expansionBudget);
+    void nextPass();
+    float provedBound();
+    string getPath(PackedState start);
+
+public:
+    // results of the last search
+    int numOfStateExpansions;
+    int maxQLength;
+    int numOfDecreaseKeys;
+    int numOfReopened;
+    int numOfGeneratedNodes;
+    float suboptimalityBound;           // 0 if no path was found
+
+    AnytimeSearch();
+
+    // Memory for the nodes of the last search (see search_metrics.h). The arena is only reset between searches.
+    size_t bytesUsed() {
+        return nodeArena.bytesUsed() + maxQLength * sizeof(AnytimeNode *) + seen.size() * sizeof(int);
+    }
+
+    string search(PackedState start, const GoalContext &goal, heuristicFunction heuristic, float initialWeight, float weightStep,
+                  float timeBudget, int expansionBudget, anytimeReport report);
+};
+
+#endif
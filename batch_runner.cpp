@@ -0,0 +1,351 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include "batch_runner.h"
+#include "search_api.h"
+
+using namespace std;
+
+
+// Result of a job that couldn't be run, every counter 0
+static BatchResult notRun() {
+
+    BatchResult result;
+    result.knownAlgorithm = false;
+    result.status = noSolutionFound;
+    result.pathLength = 0;
+    result.numOfStateExpansions = 0;
+    result.maxQLength = 0;
+    result.actualRunningTime = 0.0;
+    result.numOfDeletionsFromMiddleOfHeap = 0;
+    result.numOfLocalLoopsAvoided = 0;
+    result.numOfAttemptedNodeReExpansions = 0;
+    return result;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Runs one job in 'context'. Takes the same algorithm names as a
+//      single_run, with the defaults it uses for the weighted (w = 2) and
+//      anytime (1 second) searches. HDA* and parallel IDA* run on
+//      'searchThreads' threads (0 = one per core).
+//
+///////////////////////////////////////////////////////////////////////////////
+BatchResult runSearch(SearchContext &context, BatchJob const &job, int searchThreads) {
+
+    SearchRequest request(job.initialState, job.goalState);
+    if(!requestNamed(job.algorithm, request)) {
+        return notRun();
+    }
+    request.numThreads = searchThreads;
+
+    SearchResult found = solve(request, context);
+
+    BatchResult result;
+    result.knownAlgorithm = true;
+    result.status = found.status;
+    result.path = move(found.path);
+    found.metrics.getCounters(result.pathLength, result.numOfStateExpansions, result.maxQLength, result.actualRunningTime,
+                              result.numOfDeletionsFromMiddleOfHeap, result.numOfLocalLoopsAvoided,
+                              result.numOfAttemptedNodeReExpansions);
+    return result;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// Shared by the threads of one runBatch()
+struct BatchState {
+    vector<BatchJob> const &jobs;
+    vector<BatchResult> &results;
+    batchOutput output;
+
+    atomic<int> nextJob;                // next job not yet taken by a thread
+
+    mutex outputLock;                   // guards the two below, and the calls to 'output'
+    vector<bool> finished;
+    int nextToOutput;                   // every job before this has been given to 'output'
+
+    BatchState(vector<BatchJob> const &jobs, vector<BatchResult> &results, batchOutput output)
+        : jobs(jobs), results(results), output(output), nextJob(0), finished(jobs.size(), false), nextToOutput(0) {}
+};
+
+
+// Takes jobs until there are none left. A finished job is passed on (with any finished jobs after it)
+// once every job before it has been passed on.
+static void batchWorker(BatchState &batch) {
+
+    unique_ptr<SearchContext> context(new SearchContext());
+    int count = batch.jobs.size();
+
+    while(true) {
+        int job = batch.nextJob++;
+        if(job >= count) {
+            break;
+        }
+
+        batch.results[job] = runSearch(*context, batch.jobs[job], 1);     // the pool is already one thread per core
+
+        lock_guard<mutex> lock(batch.outputLock);
+        batch.finished[job] = true;
+
+        while(batch.nextToOutput < count && batch.finished[batch.nextToOutput]) {
+            if(batch.output != NULL) {
+                batch.output(batch.jobs[batch.nextToOutput], batch.results[batch.nextToOutput]);
+            }
+            batch.nextToOutput++;
+        }
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Runs every job of the batch on a pool of threads, and returns the
+//      results in the order of 'jobs'.
+//
+///////////////////////////////////////////////////////////////////////////////
+vector<BatchResult> runBatch(vector<BatchJob> const &jobs, int numThreads, batchOutput output) {
+
+    vector<BatchResult> results(jobs.size());
+
+    if(numThreads <= 0) {
+        numThreads = thread::hardware_concurrency();
+    }
+    if(numThreads > (int)jobs.size()) {
+        numThreads = jobs.size();
+    }
+    if(numThreads < 1) {
+        numThreads = 1;
+    }
+
+    BatchState batch(jobs, results, output);
+
+    vector<thread> pool;
+    for(int i = 0; i < numThreads; i++) {
+        pool.push_back(thread(batchWorker, ref(batch)));
+    }
+    for(int i = 0; i < numThreads; i++) {
+        pool[i].join();
+    }
+
+    return results;
+}
+
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// A record of a streamed batch, from when it is read until its result is written
+struct StreamSlot {
+    long long lineNumber;
+    bool validRecord;                   // false if the line couldn't be read as a record (nothing is run)
+    bool done;
+    BatchJob job;
+    BatchResult result;
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  A streamed batch. The records in progress are kept in a ring of 'window' slots: record
+//  n goes in slot n % window. The calling thread reads records into the ring, and waits
+//  when it is full. The threads take records in order, and whichever thread finishes the
+//  oldest record writes it and every finished record after it, freeing their slots.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class BatchStream {
+
+private:
+    istream &input;
+    ostream &output;
+    string defaultAlgorithm;
+
+    vector<StreamSlot> slots;
+    long long window;
+
+    mutex lock;                         // guards everything below, and writing to 'output'
+    condition_variable recordRead;
+    condition_variable slotFree;
+    long long numRead;                  // records read into the ring
+    long long numStarted;               // records taken by a thread
+    long long numWritten;               // records written, their slots are free again
+    bool endOfInput;
+
+    bool readRecord(string const &line, StreamSlot &slot);
+    void writeRecord(StreamSlot const &slot);
+    void run();
+
+public:
+    BatchStream(istream &input, ostream &output, string const &defaultAlgorithm, int window);
+
+    long long process(int numThreads);
+};
+
+
+BatchStream::BatchStream(istream &input, ostream &output, string const &defaultAlgorithm, int window)
+    : input(input), output(output), defaultAlgorithm(defaultAlgorithm), slots(window), window(window), numRead(0), numStarted(0),
+      numWritten(0), endOfInput(false) {}
+
+
+// Removes the spaces (and a '\r' left by a Windows line end) around a field
+static string trimField(string const &field) {
+
+    size_t first = field.find_first_not_of(" \t\r");
+    if(first == string::npos) {
+        return "";
+    }
+    size_t last = field.find_last_not_of(" \t\r");
+    return field.substr(first, last - first + 1);
+}
+
+
+// Splits 'line' into the slot's job. Returns false if it isn't a record (blank or a comment).
+bool BatchStream::readRecord(string const &line, StreamSlot &slot) {
+
+    string trimmed = trimField(line);
+    if(trimmed.empty() || trimmed[0] == '#') {
+        return false;
+    }
+
+    vector<string> fields;
+    stringstream fieldStream(trimmed);
+    string field;
+    while(getline(fieldStream, field, ',')) {
+        fields.push_back(trimField(field));
+    }
+
+    slot.job.initialState = (fields.size() > 0) ? fields[0] : "";
+    slot.job.goalState = (fields.size() > 1) ? fields[1] : "";
+    slot.job.algorithm = (fields.size() > 2 && !fields[2].empty()) ? fields[2] : defaultAlgorithm;
+    transform(slot.job.algorithm.begin(), slot.job.algorithm.end(), slot.job.algorithm.begin(), ::tolower);
+
+    slot.validRecord = (fields.size() == 2 || fields.size() == 3) && isBoard(slot.job.initialState) && isBoard(slot.job.goalState);
+    slot.done = false;
+    return true;
+}
+
+
+void BatchStream::writeRecord(StreamSlot const &slot) {
+
+    BatchResult const &result = slot.result;
+    string status;
+
+    if(!slot.validRecord || result.status == invalidBoard) status = "invalid_input";
+    else if(!result.knownAlgorithm) status = "unknown_algorithm";
+    else if(result.status == solutionFound) status = "solved";
+    else if(result.status == unsolvable) status = "unsolvable";
+    else status = "no_solution";
+
+    output << slot.lineNumber << ',' << slot.job.initialState << ',' << slot.job.goalState << ',' << slot.job.algorithm << ','
+           << status << ',' << result.pathLength << ',' << result.numOfStateExpansions << ',' << result.maxQLength << ','
+           << result.actualRunningTime << ',' << result.numOfDeletionsFromMiddleOfHeap << ',' << result.numOfLocalLoopsAvoided << ','
+           << result.numOfAttemptedNodeReExpansions << ',' << result.path << '\n';
+}
+
+
+// The loop of one thread: takes the next record read, solves it, then writes whatever is ready
+void BatchStream::run() {
+
+    unique_ptr<SearchContext> context(new SearchContext());
+
+    while(true) {
+        unique_lock<mutex> guard(lock);
+        recordRead.wait(guard, [this] { return numStarted < numRead || endOfInput; });
+        if(numStarted == numRead) {
+            break;
+        }
+        StreamSlot &slot = slots[numStarted % window];
+        numStarted++;
+        guard.unlock();
+
+        // the slot can't be reused until it has been written, so it is safe to use without the lock
+        slot.result = slot.validRecord ? runSearch(*context, slot.job, 1) : notRun();
+
+        guard.lock();
+        slot.done = true;
+
+        bool wrote = false;
+        while(numWritten < numRead && slots[numWritten % window].done) {
+            writeRecord(slots[numWritten % window]);
+            slots[numWritten % window].done = false;
+            numWritten++;
+            wrote = true;
+        }
+        if(wrote) {
+            output.flush();
+            slotFree.notify_one();
+        }
+    }
+}
+
+
+long long BatchStream::process(int numThreads) {
+
+    output << "LINE,INIT_STATE,GOAL_STATE,ALGORITHM,STATUS,PATH_LENGTH,STATE_EXPANSIONS,MAX_QLENGTH,RUNNING_TIME,"
+           << "DELETIONS_MIDDLE_HEAP,LOCAL_LOOPS_AVOIDED,ATTEMPTED_REEXPANSIONS,PATH" << endl;
+    output << fixed << setprecision(6);
+
+    vector<thread> pool;
+    for(int i = 0; i < numThreads; i++) {
+        pool.push_back(thread(&BatchStream::run, this));
+    }
+
+    string line;
+    long long lineNumber = 0;
+
+    while(getline(input, line)) {
+        lineNumber++;
+
+        unique_lock<mutex> guard(lock);
+        slotFree.wait(guard, [this] { return numRead - numWritten < window; });
+
+        StreamSlot &slot = slots[numRead % window];
+        if(!readRecord(line, slot)) {
+            continue;
+        }
+        slot.lineNumber = lineNumber;
+        numRead++;
+        recordRead.notify_one();
+    }
+
+    {
+        lock_guard<mutex> guard(lock);
+        endOfInput = true;
+    }
+    recordRead.notify_all();
+
+    for(int i = 0; i < numThreads; i++) {
+        pool[i].join();
+    }
+    return numRead;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Runs a streamed batch, see BatchStream.
+//
+///////////////////////////////////////////////////////////////////////////////
+long long runBatchStream(istream &input, ostream &output, string const &defaultAlgorithm, int numThreads, int window) {
+
+    if(numThreads <= 0) {
+        numThreads = thread::hardware_concurrency();
+    }
+    if(numThreads < 1) {
+        numThreads = 1;
+    }
+    if(window <= 0) {
+        window = 4 * numThreads;
+    }
+
+    BatchStream stream(input, output, defaultAlgorithm, window);
+    return stream.process(numThreads);
+}
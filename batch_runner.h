@@ -0,0 +1,72 @@
+#ifndef __BATCH_RUNNER_H__
+#define __BATCH_RUNNER_H__
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "search_context.h"
+
+using namespace std;
+
+
+// One search of a batch. 'algorithm' is a name as given on the command line, e.g. "astar_explist_manhattan"
+struct BatchJob {
+    string algorithm;
+    string initialState;
+    string goalState;
+};
+
+// What one search of a batch returned, the same counters as the single search functions
+struct BatchResult {
+    bool knownAlgorithm;                // false if the job's algorithm name was not recognised (nothing was run)
+    searchStatus status;
+    string path;
+    int pathLength;
+    int numOfStateExpansions;
+    int maxQLength;
+    float actualRunningTime;
+    int numOfDeletionsFromMiddleOfHeap;
+    int numOfLocalLoopsAvoided;
+    int numOfAttemptedNodeReExpansions;
+};
+
+// Called with each finished job, in the order of the jobs
+typedef void (*batchOutput)(BatchJob const &job, BatchResult const &result);
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  runSearch() - runs one job in 'context'. HDA* and parallel IDA* jobs use 'searchThreads'
+//                threads of their own.
+//
+//  runBatch()  - runs every job on a pool of 'numThreads' threads (0 = one per core). Each
+//                thread has its own SearchContext and takes the next job not yet started,
+//                so long and short searches even out across the threads. 'output' (if not
+//                NULL) gets each result as soon as it and every job before it have finished,
+//                so the results always come out in the order of 'jobs'.
+//
+//  The pools already use every core, so a job run by one of them gets one thread of its
+//  own: an HDA* or parallel IDA* job starting a thread per core as well would run N x N
+//  threads on N cores.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+BatchResult runSearch(SearchContext &context, BatchJob const &job, int searchThreads = 1);
+vector<BatchResult> runBatch(vector<BatchJob> const &jobs, int numThreads = 0, batchOutput output = NULL);
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  runBatchStream() - runs jobs read from 'input' on a pool of 'numThreads' threads, one
+//                     "initial,goal[,algorithm]" record per line ('defaultAlgorithm' if the
+//                     record has none). Blank lines and lines starting with '#' are skipped.
+//
+//  Writes a header, then one comma separated result per record to 'output', in the order
+//  of the input, each as soon as it and every record before it are done. Only 'window'
+//  records (0 = 4 per thread) are read ahead of the last one written, so memory stays the
+//  same however long the input is. Returns the number of records.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+long long runBatchStream(istream &input, ostream &output, string const &defaultAlgorithm, int numThreads = 0, int window = 0);
+
+#endif
@@ -0,0 +1,186 @@
+#include <climits>
+#include "algorithm.h"
+
+using namespace std;
+
+
+const int SearchDirection::NOT_REACHED;
+
+
+// Empties this side (only un-marking the states it reached) and starts it again from 'root'
+void SearchDirection::reset(PackedState root) {
+
+    for(size_t i = 0; i < states.size(); i++) {
+        nodeOf[rankState(states[i])] = NOT_REACHED;
+    }
+    nodeStore.clear();
+    states.clear();
+    gCosts.clear();
+    layerStart = 0;
+
+    nodeStore.addRoot();
+    states.push_back(root);
+    gCosts.push_back(0);
+    nodeOf[rankState(root)] = 0;
+}
+
+
+// Adds a node reached from 'parent' by 'move', returns its number
+int SearchDirection::addNode(PackedState state, int parent, moveDirection move) {
+
+    int node = nodeStore.addNode(parent, move);
+    states.push_back(state);
+    gCosts.push_back(gCosts[parent] + 1);
+    nodeOf[rankState(state)] = node;
+    return node;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// The move that undoes 'move' (U <-> D, L <-> R)
+static char reverseMove(char move) {
+    switch(move) {
+        case 'U': return 'D';
+        case 'D': return 'U';
+        case 'L': return 'R';
+        default:  return 'L';
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Expands the whole next layer of 'side'. Any child already reached
+//      by the 'other' side is a meeting point, the cheapest one is kept in
+//      'bestCost', 'sideMeet' and 'otherMeet'.
+//
+///////////////////////////////////////////////////////////////////////////////
+void SearchContext::expandLayer(SearchDirection &side, SearchDirection &other, int &bestCost, int &sideMeet, int &otherMeet) {
+
+    int layerEnd = side.size();
+
+    for(int node = side.layerStart; node < layerEnd; node++) {
+
+        PackedState state = side.getState(node);
+        const BlankMoves &moves = blankMoves[blankIndex(state)];
+        numOfStateExpansions++;
+
+        for(int i = 0; i < moves.count; i++) {
+
+            PackedState child = slideBlank(state, moves.cell[i]);
+            numOfGeneratedNodes++;
+
+            // this side already reached it at the same or lower cost
+            if(side.findNode(child) != SearchDirection::NOT_REACHED) {
+                numOfAttemptedNodeReExpansions++;
+                continue;
+            }
+
+            int childNode = side.addNode(child, node, moves.move[i]);
+            int otherNode = other.findNode(child);
+
+            if(otherNode != SearchDirection::NOT_REACHED) {
+                int cost = side.getGCost(childNode) + other.getGCost(otherNode);
+                if(cost < bestCost) {
+                    bestCost = cost;
+                    sideMeet = childNode;
+                    otherMeet = otherNode;
+                }
+            }
+        }
+    }
+
+    side.layerStart = layerEnd;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Search Algorithm:  Bidirectional Uniform Cost
+//
+//  Searches forward from the start and backward from the goal (every move can be undone,
+//  so searching back from the goal uses the same moves). Each step expands a whole layer
+//  of whichever side has the smaller frontier. Because a whole layer is done at once, the
+//  cheapest meeting found during the first layer that meets the other side is optimal,
+//  so the search stops at the end of that layer.
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+string SearchContext::bidirectionalUniformCost(string const initialState, string const goalState) {
+
+    reset();
+    SearchTime startTime = searchClock();
+    string path = "";
+
+    if(rejectUnsolvable(initialState, goalState)) {
+        return path;
+    }
+
+    if(!forwardSide) {
+        forwardSide.reset(new SearchDirection());
+        backwardSide.reset(new SearchDirection());
+    }
+    SearchDirection &forward = *forwardSide;
+    SearchDirection &backward = *backwardSide;
+
+    forward.reset(packBoard(initialState));
+    backward.reset(packBoard(goalState));
+
+    int bestCost = INT_MAX;
+    int forwardMeet = 0;
+    int backwardMeet = 0;
+
+    if(forward.getState(0) == backward.getState(0)) {
+        bestCost = 0;
+    }
+
+    // stop when the sides have met, or when either side has run out of states (no solution)
+    while(bestCost == INT_MAX && forward.frontierSize() > 0 && backward.frontierSize() > 0) {
+
+        if(forward.frontierSize() <= backward.frontierSize()) {
+            expandLayer(forward, backward, bestCost, forwardMeet, backwardMeet);
+        }
+        else {
+            expandLayer(backward, forward, bestCost, backwardMeet, forwardMeet);
+        }
+
+        if(forward.frontierSize() + backward.frontierSize() > maxQLength) {
+            maxQLength = forward.frontierSize() + backward.frontierSize();
+        }
+    }
+
+    // path to the meeting point, then the backward path from there to the goal (reversed and undone)
+    if(bestCost != INT_MAX) {
+        status = solutionFound;
+        path = forward.getPath(forwardMeet);
+
+        string backPath = backward.getPath(backwardMeet);
+        for(int i = backPath.length() - 1; i >= 0; i--) {
+            path += reverseMove(backPath[i]);
+        }
+    }
+
+    actualRunningTime = secondsSince(startTime);
+    pathLength = path.length();
+    peakMemoryBytes = forward.bytesUsed() + backward.bytesUsed();
+    return path;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Same interface as uc_explist(), runs in the default context
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+string uc_bidirectional(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                    float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                    int &numOfAttemptedNodeReExpansions) {
+
+    string path = defaultContext.bidirectionalUniformCost(initialState, goalState);
+
+    defaultContext.getCounters(pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap,
+                               numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
+    return path;
+}
@@ -0,0 +1,69 @@
+#ifndef __BIDIRECTIONAL_H__
+#define __BIDIRECTIONAL_H__
+
+#include <vector>
+
+#include "node_store.h"
+#include "permutation.h"
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  One side of a bidirectional search (from the start, or back from the goal).
+//  Nodes are numbered in the order they are reached. As every move costs 1, a side is
+//  searched one whole layer (all nodes the same distance from its root) at a time, so the
+//  frontier is just the range of node numbers from 'layerStart' to the end.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class SearchDirection {
+
+private:
+    NodeStore nodeStore;                // parent and move of each node
+    vector<PackedState> states;         // board of each node
+    vector<int> gCosts;                 // distance of each node from this side's root
+    vector<int> nodeOf;                 // node for each permutation rank, NOT_REACHED if not reached
+
+public:
+    static const int NOT_REACHED = -1;
+
+    int layerStart;                     // first node of the layer to expand next
+
+    SearchDirection() : nodeOf(NUM_PERMUTATIONS, NOT_REACHED), layerStart(0) {}
+
+    void reset(PackedState root);
+    int addNode(PackedState state, int parent, moveDirection move);
+
+    int findNode(PackedState state) {
+        return nodeOf[rankState(state)];
+    }
+
+    int size() {
+        return states.size();
+    }
+
+    // number of nodes reached but not yet expanded
+    int frontierSize() {
+        return states.size() - layerStart;
+    }
+
+    PackedState getState(int node) {
+        return states[node];
+    }
+
+    int getGCost(int node) {
+        return gCosts[node];
+    }
+
+    // Memory taken by the nodes reached so far
+    size_t bytesUsed() {
+        return states.size() * (sizeof(NodeRecord) + sizeof(PackedState) + sizeof(int));
+    }
+
+    string getPath(int node) {
+        return nodeStore.getPath(node);
+    }
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "board.h"
+
+using namespace std;
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Packs a board string (e.g. "123456780") into a PackedState.
+//      Cell 'n' of the string goes into bits 4n - 4n+3.
+//
+///////////////////////////////////////////////////////////////////////////////
+PackedState packBoard(string const elements) {
+
+    PackedState state = 0;
+
+    for(int n = 0; n < NUM_CELLS; n++) {
+        PackedState tile = elements[n] - '0';
+        state |= tile << (4 * n);
+
+        if(tile == 0) {
+            state |= (PackedState)n << BLANK_SHIFT;
+        }
+    }
+
+    return state;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Unpacks a PackedState back into its string representation
+//
+///////////////////////////////////////////////////////////////////////////////
+string unpackBoard(PackedState state) {
+
+    string elements(NUM_CELLS, '0');
+
+    for(int n = 0; n < NUM_CELLS; n++) {
+        elements[n] = tileAt(state, n) + '0';
+    }
+
+    return elements;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// Checks a board string from outside the program (e.g. a batch file) before it is packed
+bool isBoard(string const elements) {
+
+    if((int)elements.length() != NUM_CELLS) {
+        return false;
+    }
+
+    bool used[NUM_CELLS] = {false};
+    for(int n = 0; n < NUM_CELLS; n++) {
+        int tile = elements[n] - '0';
+        if(tile < 0 || tile >= NUM_CELLS || used[tile]) {
+            return false;
+        }
+        used[tile] = true;
+    }
+
+    return true;
+}
@@ -0,0 +1,84 @@
+#ifndef __BOARD_H__
+#define __BOARD_H__
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Packed board state
+//      Each of the 9 cells (row major, cell 0 = top left) takes 4 bits in bits 0 - 35.
+//      The index of the blank/0 tile is kept in bits 36 - 39 so it never needs searching for.
+//      The whole state fits in one 64 bit integer, so hashing and equality are a single op.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+typedef uint64_t PackedState;
+
+const int BOARD_DIM = 3;                        // width/height of the board
+const int NUM_CELLS = BOARD_DIM * BOARD_DIM;    // number of cells (and tiles, including the blank)
+const int BLANK_SHIFT = 4 * NUM_CELLS;          // bit position of the blank index
+const int MAX_SOLUTION_LENGTH = 31;             // every solvable 3x3 board can be solved in at most 31 moves
+
+
+// The four moves of the blank tile, in the order the searches try them. Fits in 2 bits.
+enum moveDirection{upMove, rightMove, downMove, leftMove};
+
+const char moveLetters[4] = {'U', 'R', 'D', 'L'};
+
+
+// Legal moves of the blank from one cell, in the order U, R, D, L
+struct BlankMoves {
+    int count;                  // number of legal moves
+    int cell[4];                // cell the blank moves to
+    moveDirection move[4];      // direction of that move
+};
+
+// Move table indexed by the blank's cell, so generating children needs no edge checks
+constexpr BlankMoves blankMoves[NUM_CELLS] = {
+    { 2, {1, 3},       {rightMove, downMove} },                     // 0  top left
+    { 3, {2, 4, 0},    {rightMove, downMove, leftMove} },           // 1
+    { 2, {5, 1},       {downMove, leftMove} },                      // 2  top right
+    { 3, {0, 4, 6},    {upMove, rightMove, downMove} },             // 3
+    { 4, {1, 5, 7, 3}, {upMove, rightMove, downMove, leftMove} },   // 4  centre
+    { 3, {2, 8, 4},    {upMove, downMove, leftMove} },              // 5
+    { 2, {3, 7},       {upMove, rightMove} },                       // 6  bottom left
+    { 3, {4, 8, 6},    {upMove, rightMove, leftMove} },             // 7
+    { 2, {5, 7},       {upMove, leftMove} }                         // 8  bottom right
+};
+
+
+// Returns the tile number stored in a cell
+inline int tileAt(PackedState state, int cell) {
+    return (int)((state >> (4 * cell)) & 0xF);
+}
+
+// Returns the cell index of the blank/0 tile
+inline int blankIndex(PackedState state) {
+    return (int)((state >> BLANK_SHIFT) & 0xF);
+}
+
+// Slides the tile in cell 'dest' into the blank cell, so the blank ends up at 'dest'.
+// 'dest' must be next to the blank, this is not checked.
+inline PackedState slideBlank(PackedState state, int dest) {
+    int blank = blankIndex(state);
+    PackedState tile = (state >> (4 * dest)) & 0xF;
+
+    state &= ~((PackedState)0xF << (4 * dest));                     // dest cell now holds the blank (0)
+    state |= tile << (4 * blank);                                   // old blank cell (was 0) gets the tile
+    state &= ~((PackedState)0xF << BLANK_SHIFT);
+    state |= (PackedState)dest << BLANK_SHIFT;                      // record the new blank position
+    return state;
+}
+
+
+// Converts between the "123456780" string form and the packed form
+PackedState packBoard(string const elements);
+string unpackBoard(PackedState state);
+
+// True if 'elements' is a board: the digits 0 - 8, each once
+bool isBoard(string const elements);
+
+#endif
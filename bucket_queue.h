@@ -0,0 +1,174 @@
+#ifndef __BUCKET_QUEUE_H__
+#define __BUCKET_QUEUE_H__
+
+#include <vector>
+
+#include "permutation.h"
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Bucket (radix) priority queue for small integer costs. Has the same interface as
+//  IndexedHeap so the searches can use either one for 'Q'.
+//
+//      T   - element type, a pointer to a node with getState() and getGCost()
+//      Key - returns the cost to order on (g for Uniform Cost, f for A*)
+//
+//  buckets[key][g] holds the elements with that key and g-cost. Pop takes from the lowest
+//  key, and within it the highest g (the deepest node, closest to a goal). Push is O(1), and
+//  pop only has to walk forward over empty buckets, so it is amortised O(1).
+//
+//  Elements live in 'items' and the buckets hold their slot numbers, so a slot stays the
+//  same while an element moves between buckets on a decrease-key.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T, typename Key>
+class BucketQueue {
+
+private:
+    vector<vector<vector<int> > > buckets;     // slots of the elements, by [key][g]
+    vector<int> keyCount;                      // number of elements with each key
+
+    vector<T> items;                           // elements, by slot
+    vector<int> bucketPos;                     // position of each slot within its bucket
+    vector<int> freeSlots;                     // slots of popped elements, reused first
+
+    vector<int> slotOf;                        // slot of each state by rank, NOT_IN_Q if not in 'Q'
+    int count;
+    int minKey;                                // no element has a key lower than this
+    Key key;
+
+    vector<int> &bucketFor(T &item) {
+        int k = key(item);
+        int g = item->getGCost();
+
+        if(k >= (int)buckets.size()) {
+            buckets.resize(k + 1);
+            keyCount.resize(k + 1, 0);
+        }
+        if(g >= (int)buckets[k].size()) {
+            buckets[k].resize(g + 1);
+        }
+        return buckets[k][g];
+    }
+
+    // Adds 'slot' to the bucket of the element stored in it
+    void addToBucket(int slot) {
+        vector<int> &bucket = bucketFor(items[slot]);
+        bucketPos[slot] = bucket.size();
+        bucket.push_back(slot);
+
+        int k = key(items[slot]);
+        keyCount[k]++;
+        if(k < minKey) {
+            minKey = k;
+        }
+    }
+
+    // Takes 'slot' out of its bucket by swapping the last element of the bucket into its place
+    void removeFromBucket(int slot) {
+        vector<int> &bucket = bucketFor(items[slot]);
+        int last = bucket.back();
+
+        bucket[bucketPos[slot]] = last;
+        bucketPos[last] = bucketPos[slot];
+        bucket.pop_back();
+
+        keyCount[key(items[slot])]--;
+    }
+
+public:
+    static const int NOT_IN_Q = -1;
+
+    BucketQueue() : slotOf(NUM_PERMUTATIONS, NOT_IN_Q), count(0), minKey(0) {}
+
+    bool empty() {
+        return count == 0;
+    }
+
+    int size() {
+        return count;
+    }
+
+    // Empties 'Q'. Keeps the bucket memory for the next search
+    void clear() {
+        for(size_t k = 0; k < buckets.size(); k++) {
+            for(size_t g = 0; g < buckets[k].size(); g++) {
+                for(size_t i = 0; i < buckets[k][g].size(); i++) {
+                    slotOf[rankState(items[buckets[k][g][i]]->getState())] = NOT_IN_Q;
+                }
+                buckets[k][g].clear();
+            }
+            keyCount[k] = 0;
+        }
+        items.clear();
+        bucketPos.clear();
+        freeSlots.clear();
+        count = 0;
+        minKey = 0;
+    }
+
+    // Returns the slot holding 'state', or NOT_IN_Q
+    int find(PackedState state) {
+        return slotOf[rankState(state)];
+    }
+
+    T &at(int slot) {
+        return items[slot];
+    }
+
+    void push(T &item) {
+        int slot;
+        if(!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            items[slot] = item;
+        }
+        else {
+            slot = items.size();
+            items.push_back(item);
+            bucketPos.push_back(0);
+        }
+
+        slotOf[rankState(item->getState())] = slot;
+        addToBucket(slot);
+        count++;
+    }
+
+    // Removes and returns the lowest cost element (highest g-cost on a tie)
+    T pop() {
+        while(keyCount[minKey] == 0) {
+            minKey++;
+        }
+
+        vector<vector<int> > &byGCost = buckets[minKey];
+        int g = byGCost.size() - 1;
+        while(byGCost[g].empty()) {
+            g--;
+        }
+
+        int slot = byGCost[g].back();
+        byGCost[g].pop_back();
+        keyCount[minKey]--;
+        count--;
+
+        freeSlots.push_back(slot);
+        slotOf[rankState(items[slot]->getState())] = NOT_IN_Q;
+        return items[slot];
+    }
+
+    // Replaces the element in 'slot' with a lower cost version of the same state
+    void decreaseKey(int slot, T &item) {
+        removeFromBucket(slot);
+        items[slot] = item;
+        addToBucket(slot);
+    }
+};
+
+// NOT_IN_Q is passed by reference (e.g. to vector), so it needs a definition
+template <typename T, typename Key>
+const int BucketQueue<T, Key>::NOT_IN_Q;
+
+#endif
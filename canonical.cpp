@@ -0,0 +1,40 @@
+#include "canonical.h"
+
+using namespace std;
+
+
+PackedState canonicalGoal(int blank) {
+
+    string goal = "";
+    char tile = '1';
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        goal += (cell == blank) ? '0' : tile++;
+    }
+    return packBoard(goal);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// Each tile is renamed to the tile the standard goal has in that tile's goal cell
+GoalRelabeling::GoalRelabeling(string const goal) {
+
+    PackedState requested = packBoard(goal);
+    blank = blankIndex(requested);
+
+    PackedState standard = canonicalGoal(blank);
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        label[tileAt(requested, cell)] = tileAt(standard, cell);
+    }
+}
+
+
+// The blank keeps its name (0) and its cell, so only the tile nibbles change
+PackedState GoalRelabeling::relabel(PackedState state) const {
+
+    PackedState renamed = state & ((PackedState)0xF << BLANK_SHIFT);
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        renamed |= (PackedState)label[tileAt(state, cell)] << (4 * cell);
+    }
+    return renamed;
+}
@@ -0,0 +1,50 @@
+#ifndef __CANONICAL_H__
+#define __CANONICAL_H__
+
+#include <string>
+
+#include "board.h"
+
+using namespace std;
+
+
+// Standard goal for a blank cell: tiles 1-8 in order, skipping the blank's cell ("123456780" for cell 8)
+PackedState canonicalGoal(int blank);
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Renames the tiles so a requested goal becomes the standard goal for its blank cell, and
+//  renames any other board the same way. A board is the same distance from the goal before
+//  and after renaming, and the blank moves the same way, so a search can run on the renamed
+//  boards and its path (e.g. "DDLURD") is the answer for the original boards unchanged.
+//
+//  Tables built for the standard goals (pattern databases, distance tables, ...) then serve
+//  every goal, instead of being built again for each goal string.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class GoalRelabeling {
+
+private:
+    int blank;                      // cell of the goal's blank, picks the standard goal
+    int label[NUM_CELLS];           // new name of each tile, indexed by its name in the requested goal
+
+public:
+    explicit GoalRelabeling(string const goal);
+
+    int getBlank() const {
+        return blank;
+    }
+
+    PackedState getCanonicalGoal() const {
+        return canonicalGoal(blank);
+    }
+
+    PackedState relabel(PackedState state) const;
+
+    string relabel(string const state) const {
+        return unpackBoard(relabel(packBoard(state)));
+    }
+};
+
+#endif
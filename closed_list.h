@@ -0,0 +1,42 @@
+#ifndef __CLOSED_LIST_H__
+#define __CLOSED_LIST_H__
+
+#include <cstdint>
+#include <cstring>
+
+#include "permutation.h"
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Strict expanded list as a bitset with one bit per permutation rank (9! bits = 45KB).
+//  Membership is a single bit test with no allocation, and the whole list sits in L2.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class ClosedList {
+
+private:
+    static const int NUM_WORDS = (NUM_PERMUTATIONS + 63) / 64;
+    uint64_t bits[NUM_WORDS];
+
+public:
+    ClosedList() {
+        clear();
+    }
+
+    void clear() {
+        memset(bits, 0, sizeof(bits));
+    }
+
+    bool contains(PackedState state) const {
+        int rank = rankState(state);
+        return (bits[rank >> 6] >> (rank & 63)) & 1;
+    }
+
+    void insert(PackedState state) {
+        int rank = rankState(state);
+        bits[rank >> 6] |= (uint64_t)1 << (rank & 63);
+    }
+};
+
+#endif
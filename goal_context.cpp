@@ -0,0 +1,314 @@
+#include <cstdlib>
+#include "goal_context.h"
+
+using namespace std;
+
+
+// Tiles in each pattern, 1-4 and 5-8
+static const int patternTiles[NUM_PATTERNS][MAX_PATTERN_TILES] = {
+    {1, 2, 3, 4},
+    {5, 6, 7, 8}
+};
+
+
+// File a pattern database for 'goal' is saved to/loaded from, e.g. "pdb_123456780_0.dat"
+static string patternFileName(string const goal, int pattern) {
+    return "pdb_" + goal + "_" + to_string(pattern) + ".dat";
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Builds the goal context for a goal state string (e.g. "123456780").
+//      The Manhattan table holds |x1 - x2| + |y1 - y2| for every tile in
+//      every cell, so the heuristic never has to work out coordinates.
+//
+///////////////////////////////////////////////////////////////////////////////
+GoalContext::GoalContext(string const goal, int tables) : rowWalking(NULL), colWalking(NULL) {
+
+    goalState = packBoard(goal);
+
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        goalCell[tileAt(goalState, cell)] = cell;
+    }
+
+    for(int tile = 0; tile < NUM_CELLS; tile++) {
+        int x2 = goalCell[tile] % BOARD_DIM;
+        int y2 = goalCell[tile] / BOARD_DIM;
+
+        for(int cell = 0; cell < NUM_CELLS; cell++) {
+            int x1 = cell % BOARD_DIM;
+            int y1 = cell / BOARD_DIM;
+
+            // the blank is not counted by the heuristic
+            manhattan[tile][cell] = (tile == 0) ? 0 : abs(x1 - x2) + abs(y1 - y2);
+        }
+    }
+
+    for(int tile = 0; tile < NUM_CELLS; tile++) {
+        patternOf[tile] = -1;
+    }
+    for(int p = 0; p < NUM_PATTERNS; p++) {
+        for(int i = 0; i < MAX_PATTERN_TILES; i++) {
+            patternOf[patternTiles[p][i]] = p;
+        }
+    }
+
+    for(int p = 0; p < NUM_PATTERNS; p++) {
+        if((tables & patternTables) && !patterns[p].load(patternFileName(goal, p), goalState, patternTiles[p], MAX_PATTERN_TILES)) {
+            patterns[p].build(goalState, patternTiles[p], MAX_PATTERN_TILES);
+        }
+    }
+
+    if(tables & conflictTables) {
+        buildConflicts();
+    }
+
+    if(tables & walkingTables) {
+        rowWalking = &walkingDistanceTable(goalCell[0] / BOARD_DIM);
+        colWalking = &walkingDistanceTable(goalCell[0] % BOARD_DIM);
+    }
+}
+
+
+bool GoalContext::savePatterns() const {
+
+    for(int p = 0; p < NUM_PATTERNS; p++) {
+        if(!patterns[p].save(patternFileName(unpackBoard(goalState), p))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// Cell of each tile in 'state', indexed by tile
+static void findCells(PackedState state, int *cellOf) {
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        cellOf[tileAt(state, cell)] = cell;
+    }
+}
+
+
+int GoalContext::getPatternCost(PackedState state) const {
+
+    int costs[NUM_PATTERNS];
+    getPatternCosts(state, costs);
+
+    int sum = 0;
+    for(int p = 0; p < NUM_PATTERNS; p++) {
+        sum += costs[p];
+    }
+    return sum;
+}
+
+
+void GoalContext::getPatternCosts(PackedState state, int *costs) const {
+
+    int cellOf[NUM_CELLS];
+    findCells(state, cellOf);
+
+    for(int p = 0; p < NUM_PATTERNS; p++) {
+        costs[p] = patterns[p].getCost(cellOf);
+    }
+}
+
+
+// A database only counts moves of its own tiles, so moving any other tile is free for it and can be undone,
+// which leaves its cost as it was. Only the pattern holding the moved tile has to be looked up again.
+int GoalContext::getPatternDelta(PackedState state, int tile, int *costs) const {
+
+    int p = patternOf[tile];
+    int cellOf[NUM_CELLS];
+    findCells(state, cellOf);
+
+    int before = costs[p];
+    costs[p] = patterns[p].getCost(cellOf);
+    return costs[p] - before;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Fills the linear conflict table. For every line and every way its
+//      cells could be filled, takes the tiles that belong in that line, in
+//      the order they are in, and finds the most that are already in the
+//      right order (longest increasing run of goal positions). Every other
+//      one has to step out of the line and back in, 2 extra moves each
+//      on top of Manhattan.
+//
+///////////////////////////////////////////////////////////////////////////////
+void GoalContext::buildConflicts() {
+
+    conflicts.assign(NUM_LINES * LINE_KEYS, 0);
+
+    for(int line = 0; line < NUM_LINES; line++) {
+        bool isRow = line < BOARD_DIM;
+        int index = line % BOARD_DIM;
+
+        for(int key = 0; key < LINE_KEYS; key++) {
+
+            // goal positions, along the line, of the tiles that belong in it
+            int goalPos[BOARD_DIM];
+            int count = 0;
+
+            for(int i = 0; i < BOARD_DIM; i++) {
+                int tile = (key >> (4 * i)) & 0xF;
+                if(tile == 0 || tile >= NUM_CELLS) {
+                    continue;
+                }
+
+                int row = goalCell[tile] / BOARD_DIM;
+                int col = goalCell[tile] % BOARD_DIM;
+                if(isRow && row == index) {
+                    goalPos[count++] = col;
+                }
+                else if(!isRow && col == index) {
+                    goalPos[count++] = row;
+                }
+            }
+
+            int longest[BOARD_DIM];
+            int inOrder = 0;
+            for(int i = 0; i < count; i++) {
+                longest[i] = 1;
+                for(int j = 0; j < i; j++) {
+                    if(goalPos[j] < goalPos[i] && longest[j] + 1 > longest[i]) {
+                        longest[i] = longest[j] + 1;
+                    }
+                }
+                if(longest[i] > inOrder) {
+                    inOrder = longest[i];
+                }
+            }
+
+            conflicts[line * LINE_KEYS + key] = 2 * (count - inOrder);
+        }
+    }
+}
+
+
+// Looks up one line (rows 0 .. BOARD_DIM-1, then the columns) of 'state'
+int GoalContext::lineConflict(PackedState state, int line) const {
+
+    int key;
+    if(line < BOARD_DIM) {
+        // a row is already packed together in the state
+        key = (int)((state >> (4 * BOARD_DIM * line)) & (LINE_KEYS - 1));
+    }
+    else {
+        int col = line - BOARD_DIM;
+        key = 0;
+        for(int i = 0; i < BOARD_DIM; i++) {
+            key |= tileAt(state, i * BOARD_DIM + col) << (4 * i);
+        }
+    }
+    return conflicts[line * LINE_KEYS + key];
+}
+
+
+int GoalContext::getConflictCost(PackedState state) const {
+
+    int sum = 0;
+    for(int line = 0; line < NUM_LINES; line++) {
+        sum += lineConflict(state, line);
+    }
+    return sum;
+}
+
+
+// A move along a row leaves the order within every row as it was, it only changes the two columns
+// the tile left and joined (and the other way round for a move along a column)
+int GoalContext::getConflictDelta(PackedState state, int fromCell, int toCell) const {
+
+    PackedState before = slideBlank(state, toCell);
+    int line1, line2;
+
+    if(fromCell / BOARD_DIM == toCell / BOARD_DIM) {
+        line1 = BOARD_DIM + fromCell % BOARD_DIM;
+        line2 = BOARD_DIM + toCell % BOARD_DIM;
+    }
+    else {
+        line1 = fromCell / BOARD_DIM;
+        line2 = toCell / BOARD_DIM;
+    }
+
+    return lineConflict(state, line1) + lineConflict(state, line2)
+           - lineConflict(before, line1) - lineConflict(before, line2);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+void GoalContext::getWalkingCodes(PackedState state, int &rowCode, int &colCode) const {
+
+    rowCode = 0;
+    colCode = 0;
+
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        int tile = tileAt(state, cell);
+        if(tile != 0) {
+            rowCode += walkingCodeOf(cell / BOARD_DIM, goalCell[tile] / BOARD_DIM);
+            colCode += walkingCodeOf(cell % BOARD_DIM, goalCell[tile] % BOARD_DIM);
+        }
+    }
+}
+
+
+int GoalContext::getWalkingCost(PackedState state) const {
+
+    int rowCode, colCode;
+    getWalkingCodes(state, rowCode, colCode);
+    return rowWalking->getDistance(rowCode) + colWalking->getDistance(colCode);
+}
+
+
+// A move up or down only changes the row counts (and left or right only the column counts), and only
+// by the one tile, so the code is moved on by taking that tile out of its old line and into its new one
+int GoalContext::getWalkingDelta(int tile, int fromCell, int toCell, int &rowCode, int &colCode) const {
+
+    if(fromCell / BOARD_DIM != toCell / BOARD_DIM) {
+        int goalRow = goalCell[tile] / BOARD_DIM;
+        int before = rowWalking->getDistance(rowCode);
+        rowCode += walkingCodeOf(toCell / BOARD_DIM, goalRow) - walkingCodeOf(fromCell / BOARD_DIM, goalRow);
+        return rowWalking->getDistance(rowCode) - before;
+    }
+
+    int goalCol = goalCell[tile] % BOARD_DIM;
+    int before = colWalking->getDistance(colCode);
+    colCode += walkingCodeOf(toCell % BOARD_DIM, goalCol) - walkingCodeOf(fromCell % BOARD_DIM, goalCol);
+    return colWalking->getDistance(colCode) - before;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// Context for the goal with its blank in cell 'Blank', with the extra tables 'Tables', built on first use
+// (thread safe in C++11). Each heuristic asks for its own tables, so none is built that won't be looked up.
+template <int Blank, int Tables>
+static const GoalContext &contextFor() {
+    static const GoalContext context(unpackBoard(canonicalGoal(Blank)), Tables);
+    return context;
+}
+
+template <int Tables>
+static const GoalContext &contextWith(int blank) {
+    static const GoalContext &(*const contexts[NUM_CELLS])() = {
+        contextFor<0, Tables>, contextFor<1, Tables>, contextFor<2, Tables>, contextFor<3, Tables>, contextFor<4, Tables>,
+        contextFor<5, Tables>, contextFor<6, Tables>, contextFor<7, Tables>, contextFor<8, Tables>
+    };
+    return contexts[blank]();
+}
+
+// by every combination of goalTables
+static const GoalContext &(*const canonicalContexts[])(int) = {
+    contextWith<0>, contextWith<1>, contextWith<2>, contextWith<3>, contextWith<4>, contextWith<5>, contextWith<6>, contextWith<7>
+};
+
+const GoalContext &canonicalGoalContext(int blank, int tables) {
+    return canonicalContexts[tables](blank);
+}
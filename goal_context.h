@@ -0,0 +1,112 @@
+#ifndef __GOAL_CONTEXT_H__
+#define __GOAL_CONTEXT_H__
+
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "canonical.h"
+#include "pattern_database.h"
+#include "walking_distance.h"
+
+using namespace std;
+
+
+const int NUM_PATTERNS = 2;            // the 8 tiles are split into two disjoint patterns of 4
+const int NUM_LINES = 2 * BOARD_DIM;   // rows then columns, for the linear conflict tables
+const int LINE_KEYS = 1 << (4 * BOARD_DIM);     // a line's tiles packed 4 bits each, as in PackedState
+
+// Tables a GoalContext builds on top of the basic ones, or'ed together. Only those the heuristic needs are built.
+enum goalTables{basicTables = 0, patternTables = 1, conflictTables = 2, walkingTables = 4};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Everything about a goal state that the search needs, built once per goal and shared
+//  (by pointer) by every Puzzle of the search. Nothing in it changes after construction,
+//  so any number of searches can read the same GoalContext at once.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class GoalContext {
+
+private:
+    PackedState goalState;                      // packed GOAL board, goalMatch() is one compare against this
+    int goalCell[NUM_CELLS];                    // cell each tile should end up in, indexed by tile
+    int manhattan[NUM_CELLS][NUM_CELLS];        // Manhattan distance of a tile from its goal cell, by [tile][cell]
+
+    PatternDatabase patterns[NUM_PATTERNS];     // additive pattern databases, only filled in if asked for
+    int patternOf[NUM_CELLS];                   // pattern each tile is in, indexed by tile (-1 for the blank)
+    vector<unsigned char> conflicts;            // linear conflict penalty of a line, by [line][line key]
+    const WalkingDistanceTable *rowWalking;     // walking distance tables for rows and columns (shared, not owned)
+    const WalkingDistanceTable *colWalking;
+
+    void buildConflicts();
+    int lineConflict(PackedState state, int line) const;
+
+public:
+    // 'tables' picks the extra tables to build (goalTables). The pattern databases are loaded
+    // from file if there is one for this goal, otherwise built.
+    GoalContext(string const goal, int tables = basicTables);
+
+    // writes the pattern databases to the files the constructor loads them from
+    bool savePatterns() const;
+
+    PackedState getGoalState() const {
+        return goalState;
+    }
+
+    int getGoalCell(int tile) const {
+        return goalCell[tile];
+    }
+
+    // Distance of 'tile' from its goal cell when it is in 'cell'. Always 0 for the blank.
+    int getManhattan(int tile, int cell) const {
+        return manhattan[tile][cell];
+    }
+
+    // Sum of the pattern database costs, and the cost of each pattern. The delta takes the costs of the
+    // board before 'tile' moved (from getPatternCosts()), and leaves those after it in their place.
+    // Only valid if the context was made with 'patternTables'.
+    int getPatternCost(PackedState state) const;
+    void getPatternCosts(PackedState state, int *costs) const;
+    int getPatternDelta(PackedState state, int tile, int *costs) const;
+
+    // Linear conflict penalty (2 moves per tile that has to leave its line), and its change after
+    // the tile in 'toCell' came from 'fromCell'. Only valid if the context was made with 'conflictTables'.
+    int getConflictCost(PackedState state) const;
+    int getConflictDelta(PackedState state, int fromCell, int toCell) const;
+
+    // Walking distance (rows plus columns), and its change after 'tile' slid from 'fromCell' to 'toCell'.
+    // The delta takes the row and column codes of the board before the move (from getWalkingCodes()),
+    // and leaves the codes of the board after it in their place. Only valid if the context was made
+    // with 'walkingTables'.
+    void getWalkingCodes(PackedState state, int &rowCode, int &colCode) const;
+    int getWalkingCost(PackedState state) const;
+    int getWalkingDelta(int tile, int fromCell, int toCell, int &rowCode, int &colCode) const;
+};
+
+
+// Shared context for the standard goal of a blank cell (see canonical.h), with the extra tables
+// 'tables' (goalTables). Built the first time it is asked for, and only read after that.
+const GoalContext &canonicalGoalContext(int blank, int tables = basicTables);
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  The problem a search actually runs: the start with its tiles renamed so the goal is the
+//  standard goal for its blank cell (see canonical.h), and the shared context of that goal
+//  with the extra tables 'tables'. The path found on the renamed boards is the answer for
+//  the original boards unchanged.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct CanonicalProblem {
+    GoalRelabeling relabeling;
+    PackedState start;
+    const GoalContext &goal;
+
+    CanonicalProblem(string const initialState, string const goalState, int tables = basicTables)
+        : relabeling(goalState), start(relabeling.relabel(packBoard(initialState))),
+          goal(canonicalGoalContext(relabeling.getBlank(), tables)) {}
+};
+
+#endif
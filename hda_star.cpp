@@ -0,0 +1,461 @@
+#include <atomic>
+#include <climits>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "hda_star.h"
+#include "canonical.h"
+#include "solvability.h"
+#include "indexed_heap.h"
+#include "node_arena.h"
+#include "search_clock.h"
+
+using namespace std;
+
+
+static const int MESSAGE_BLOCK_SIZE = 64;       // children sent to another thread in one go
+static const int EXPANSIONS_PER_ROUND = 64;     // expansions between looking at the inbox
+
+// the blank's move in each direction (U, R, D, L), used to step back along the path
+static const int moveOffset[4] = {-BOARD_DIM, 1, BOARD_DIM, -1};
+
+
+// A child sent to the thread that owns it
+struct HdaMessage {
+    PackedState state;
+    int g;
+    int h;
+    HeuristicCode code;
+    int move;                   // move that reached it
+};
+
+struct HdaMessageBlock {
+    HdaMessageBlock *next;
+    int count;
+    HdaMessage messages[MESSAGE_BLOCK_SIZE];
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Lock-free inbox with many senders and one receiver. Senders push a whole block onto
+//  a linked stack with a compare-and-swap, the receiver takes every block at once by
+//  swapping in an empty list. Blocks are made by the sender and deleted by the receiver.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class HdaInbox {
+
+private:
+    atomic<HdaMessageBlock *> head;
+
+public:
+    HdaInbox() : head(NULL) {}
+
+    void push(HdaMessageBlock *block) {
+        block->next = head.load(memory_order_relaxed);
+        while(!head.compare_exchange_weak(block->next, block, memory_order_release, memory_order_relaxed)) {
+        }
+    }
+
+    // Returns every block sent so far (newest first), or NULL
+    HdaMessageBlock *takeAll() {
+        return head.exchange(NULL, memory_order_acquire);
+    }
+
+    bool empty() {
+        return head.load(memory_order_acquire) == NULL;
+    }
+};
+
+
+// A board in a thread's 'Q'
+struct HdaNode {
+    PackedState state;
+    int g;
+    int h;
+    HeuristicCode code;
+
+    PackedState getState() {
+        return state;
+    }
+};
+
+// Lowest f-cost first, the deeper node on a tie
+struct hdaFCostComparator {
+    bool operator() (HdaNode *n1, HdaNode *n2) const {
+        int f1 = n1->g + n1->h;
+        int f2 = n2->g + n2->h;
+        return f1 > f2 || (f1 == f2 && n1->g < n2->g);
+    }
+};
+
+typedef IndexedHeap<HdaNode *, hdaFCostComparator> HdaQ;
+
+
+// Everything owned by one thread
+struct HdaWorker {
+    int id;
+    HdaQ Q;
+    NodeArena<HdaNode> nodeArena;
+    HdaInbox inbox;
+    vector<HdaMessageBlock *> outgoing;     // block being filled for each other thread, or NULL
+
+    int numOfStateExpansions;
+    int maxQLength;
+    int numOfDecreaseKeys;
+    int numOfReopened;
+    int numOfGeneratedNodes;
+
+    HdaWorker(int id, int numThreads)
+        : id(id), outgoing(numThreads, (HdaMessageBlock *)NULL), numOfStateExpansions(0), maxQLength(0), numOfDecreaseKeys(0),
+          numOfReopened(0), numOfGeneratedNodes(0) {}
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  One HDA* run. gCost and parentMove are shared by all the threads, indexed by rank,
+//  but each entry is only ever read or written by the thread owning that board.
+//
+//  Termination: 'activeWork' counts the threads that are busy plus the blocks sent but
+//  not yet taken in. A thread only stops being busy when its inbox is empty and it has
+//  nothing left under the incumbent's cost, and only a busy thread sends, so once the
+//  count reaches 0 it stays there and every thread can stop.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class HdaSearch {
+
+private:
+    const GoalContext &goal;
+    heuristicFunction heuristic;
+    PackedState goalState;
+    int numThreads;
+
+    vector<int> gCost;                      // INT_MAX if not reached
+    vector<unsigned char> parentMove;
+    vector<unique_ptr<HdaWorker> > workers;
+
+    atomic<int> bestCost;                   // length of the incumbent solution, INT_MAX if none yet
+    atomic<int> activeWork;
+
+    int ownerOf(PackedState state) {
+        return (int)(((state * 0x9E3779B97F4A7C15ULL) >> 32) % numThreads);
+    }
+
+    void relax(HdaWorker &worker, PackedState state, int g, int h, HeuristicCode code, int move);
+    void send(HdaWorker &worker, int owner, PackedState state, int g, int h, HeuristicCode code, int move);
+    void post(HdaWorker &worker, int owner);
+    bool takeInbox(HdaWorker &worker);
+    bool expandSome(HdaWorker &worker);
+    void run(HdaWorker &worker);
+
+public:
+    HdaSearch(const GoalContext &goal, heuristicFunction heuristic, int numThreads);
+
+    string search(PackedState start);
+
+    // totals over the threads
+    int numOfStateExpansions;
+    int maxQLength;
+    int numOfDecreaseKeys;
+    int numOfReopened;
+    int numOfGeneratedNodes;
+    size_t peakMemoryBytes;
+};
+
+
+HdaSearch::HdaSearch(const GoalContext &goal, heuristicFunction heuristic, int numThreads)
+    : goal(goal), heuristic(heuristic), goalState(goal.getGoalState()), numThreads(numThreads), gCost(NUM_PERMUTATIONS, INT_MAX),
+      parentMove(NUM_PERMUTATIONS, 0), bestCost(INT_MAX), activeWork(0), numOfStateExpansions(0), maxQLength(0),
+      numOfDecreaseKeys(0), numOfReopened(0), numOfGeneratedNodes(0), peakMemoryBytes(0) {
+
+    for(int i = 0; i < numThreads; i++) {
+        workers.push_back(unique_ptr<HdaWorker>(new HdaWorker(i, numThreads)));
+    }
+}
+
+
+// Called by the owner of 'state' when it is reached with g-cost 'g'. Keeps it if that is cheaper than before.
+void HdaSearch::relax(HdaWorker &worker, PackedState state, int g, int h, HeuristicCode code, int move) {
+
+    int rank = rankState(state);
+    if(g >= gCost[rank]) {
+        return;
+    }
+
+    bool reachedBefore = (gCost[rank] != INT_MAX);
+    gCost[rank] = g;
+    parentMove[rank] = move;
+
+    HdaNode node;
+    node.state = state;
+    node.g = g;
+    node.h = h;
+    node.code = code;
+    HdaNode *stored = worker.nodeArena.allocate(node);
+
+    int slot = worker.Q.find(state);
+    if(slot != HdaQ::NOT_IN_Q) {
+        worker.Q.decreaseKey(slot, stored);
+        worker.numOfDecreaseKeys++;
+    }
+    else {
+        // reached before but not in 'Q', so it was expanded with a higher g-cost
+        if(reachedBefore) {
+            worker.numOfReopened++;
+        }
+        worker.Q.push(stored);
+        if(worker.Q.size() > worker.maxQLength) {
+            worker.maxQLength = worker.Q.size();
+        }
+    }
+}
+
+
+// Adds a child to the block for 'owner', sending the block when it is full
+void HdaSearch::send(HdaWorker &worker, int owner, PackedState state, int g, int h, HeuristicCode code, int move) {
+
+    HdaMessageBlock *&block = worker.outgoing[owner];
+    if(block == NULL) {
+        block = new HdaMessageBlock();
+        block->count = 0;
+    }
+
+    HdaMessage &message = block->messages[block->count++];
+    message.state = state;
+    message.g = g;
+    message.h = h;
+    message.code = code;
+    message.move = move;
+
+    if(block->count == MESSAGE_BLOCK_SIZE) {
+        post(worker, owner);
+    }
+}
+
+
+// Sends the block for 'owner'. It is counted as work before it is visible, so the count can't reach 0 while it is on its way.
+void HdaSearch::post(HdaWorker &worker, int owner) {
+    activeWork++;
+    workers[owner]->inbox.push(worker.outgoing[owner]);
+    worker.outgoing[owner] = NULL;
+}
+
+
+// Puts every child sent to this thread into its 'Q'. Returns false if there were none.
+bool HdaSearch::takeInbox(HdaWorker &worker) {
+
+    HdaMessageBlock *block = worker.inbox.takeAll();
+    bool received = (block != NULL);
+
+    while(block != NULL) {
+        int best = bestCost.load(memory_order_relaxed);
+
+        for(int i = 0; i < block->count; i++) {
+            HdaMessage &message = block->messages[i];
+            if(message.g + message.h < best) {
+                relax(worker, message.state, message.g, message.h, message.code, message.move);
+            }
+        }
+
+        HdaMessageBlock *next = block->next;
+        delete block;
+        block = next;
+        activeWork--;
+    }
+    return received;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Expands up to EXPANSIONS_PER_ROUND boards of this thread's 'Q' that
+//      could still lead to a shorter solution than the incumbent. Returns
+//      false if there were none.
+//
+///////////////////////////////////////////////////////////////////////////////
+bool HdaSearch::expandSome(HdaWorker &worker) {
+
+    bool worked = false;
+
+    for(int round = 0; round < EXPANSIONS_PER_ROUND && !worker.Q.empty(); round++) {
+
+        HdaNode *current = worker.Q.at(0);
+        if(current->g + current->h >= bestCost.load(memory_order_relaxed)) {
+            break;
+        }
+        worker.Q.pop();
+        worked = true;
+
+        // only the goal's owner gets here, so only one thread ever writes bestCost
+        if(current->state == goalState) {
+            bestCost = current->g;
+            continue;
+        }
+
+        worker.numOfStateExpansions++;
+
+        PackedState state = current->state;
+        int blank = blankIndex(state);
+        const BlankMoves &moves = blankMoves[blank];
+        int g = current->g + 1;
+        int best = bestCost.load(memory_order_relaxed);
+
+        for(int i = 0; i < moves.count; i++) {
+
+            int cell = moves.cell[i];
+            int tile = tileAt(state, cell);
+            PackedState child = slideBlank(state, cell);
+            worker.numOfGeneratedNodes++;
+            HeuristicCode code = current->code;
+            int h = current->h + heuristicDelta(child, tile, cell, blank, code, heuristic, goal);
+
+            if(g + h >= best) {
+                continue;
+            }
+
+            int owner = ownerOf(child);
+            if(owner == worker.id) {
+                relax(worker, child, g, h, code, moves.move[i]);
+            }
+            else {
+                send(worker, owner, child, g, h, code, moves.move[i]);
+            }
+        }
+    }
+    return worked;
+}
+
+
+// The loop of one thread. It is counted in 'activeWork' while busy.
+void HdaSearch::run(HdaWorker &worker) {
+
+    bool busy = true;
+
+    while(true) {
+        if(busy) {
+            bool worked = takeInbox(worker);
+            worked = expandSome(worker) || worked;
+
+            // children for other threads go out at the end of every round, not only when a block fills
+            for(int owner = 0; owner < numThreads; owner++) {
+                if(worker.outgoing[owner] != NULL) {
+                    post(worker, owner);
+                }
+            }
+
+            if(!worked) {
+                busy = false;
+                activeWork--;
+            }
+        }
+        else if(!worker.inbox.empty()) {
+            activeWork++;
+            busy = true;
+        }
+        else if(activeWork.load() == 0) {
+            break;
+        }
+        else {
+            this_thread::yield();
+        }
+    }
+}
+
+
+// Runs the threads from 'start', and returns the path to the goal ("" if there is none)
+string HdaSearch::search(PackedState start) {
+
+    relax(*workers[ownerOf(start)], start, 0, heuristicValue(start, heuristic, goal), heuristicCode(start, heuristic, goal), 0);
+
+    activeWork = numThreads;
+    vector<thread> pool;
+    for(int i = 0; i < numThreads; i++) {
+        pool.push_back(thread(&HdaSearch::run, this, ref(*workers[i])));
+    }
+    for(int i = 0; i < numThreads; i++) {
+        pool[i].join();
+    }
+
+    for(int i = 0; i < numThreads; i++) {
+        numOfStateExpansions += workers[i]->numOfStateExpansions;
+        maxQLength += workers[i]->maxQLength;
+        numOfDecreaseKeys += workers[i]->numOfDecreaseKeys;
+        numOfReopened += workers[i]->numOfReopened;
+        numOfGeneratedNodes += workers[i]->numOfGeneratedNodes;
+        peakMemoryBytes += workers[i]->nodeArena.bytesUsed() + workers[i]->maxQLength * sizeof(HdaNode *);
+    }
+
+    string path = "";
+    if(bestCost == INT_MAX) {
+        return path;
+    }
+
+    // every parent has a lower g-cost than its child, so following the moves back reaches the start
+    PackedState state = goalState;
+    while(state != start) {
+        int move = parentMove[rankState(state)];
+        path += moveLetters[move];
+        state = slideBlank(state, blankIndex(state) - moveOffset[move]);
+    }
+    return string(path.rbegin(), path.rend());
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Search Algorithm:  HDA* (hash distributed A*)
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+string hdaStar(string const initialState, string const goalState, heuristicFunction heuristic, int numThreads, SearchMetrics &metrics) {
+
+    SearchTime startTime = searchClock();
+    string path = "";
+
+    metrics.numOfStateExpansions = 0;
+    metrics.maxQLength = 0;
+    metrics.numOfDeletionsFromMiddleOfHeap = 0;
+    metrics.numOfLocalLoopsAvoided = 0;
+    metrics.numOfAttemptedNodeReExpansions = 0;
+    metrics.numOfGeneratedNodes = 0;
+    metrics.peakMemoryBytes = 0;
+
+    if(numThreads <= 0) {
+        numThreads = thread::hardware_concurrency();
+    }
+    if(numThreads < 1) {
+        numThreads = 1;
+    }
+
+    if(isSolvable(packBoard(initialState), packBoard(goalState))) {
+
+        CanonicalProblem problem(initialState, goalState, tablesFor(heuristic));
+        HdaSearch hda(problem.goal, heuristic, numThreads);
+        path = hda.search(problem.start);
+
+        metrics.numOfStateExpansions = hda.numOfStateExpansions;
+        metrics.maxQLength = hda.maxQLength;
+        metrics.numOfDeletionsFromMiddleOfHeap = hda.numOfDecreaseKeys;
+        metrics.numOfAttemptedNodeReExpansions = hda.numOfReopened;
+        metrics.numOfGeneratedNodes = hda.numOfGeneratedNodes;
+        metrics.peakMemoryBytes = hda.peakMemoryBytes;
+    }
+
+    metrics.pathLength = path.length();
+    metrics.actualRunningTime = secondsSince(startTime);
+    return path;
+}
+
+
+string hdaStar(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic, int numThreads) {
+
+    SearchMetrics metrics;
+    string path = hdaStar(initialState, goalState, heuristic, numThreads, metrics);
+
+    metrics.getCounters(pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap,
+                        numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
+    return path;
+}
@@ -0,0 +1,37 @@
+#ifndef __HDA_STAR_H__
+#define __HDA_STAR_H__
+
+#include <string>
+
+#include "heuristic.h"
+#include "search_metrics.h"
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  HDA* (hash distributed A*). A* for one board spread over 'numThreads' threads (0 = one per
+//  core). Every board is owned by one thread, picked by a hash of its packed state. Only the
+//  owner keeps the board's 'Q' entry and g-cost, so no locks are needed on them. A child
+//  owned by another thread is sent to that thread's inbox in blocks.
+//
+//  The threads don't expand in global f-cost order, so a board can be reached more cheaply
+//  after it was expanded, and it is then expanded again. The first goal found is not
+//  always optimal. It becomes the incumbent, and the search goes on until no thread has a
+//  board with a lower f-cost and no message is still on its way. The incumbent is then optimal.
+//
+//  Has the same counters as aStar_ExpandedList(), added up over the threads:
+//      maxQLength                      - the largest 'Q' of each thread, added together
+//      numOfDeletionsFromMiddleOfHeap  - boards given a lower cost while in 'Q'
+//      numOfAttemptedNodeReExpansions  - boards put back into 'Q' after being expanded
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+string hdaStar(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic, int numThreads = 0);
+
+// The same, handing back every metric. peakMemoryBytes adds up the nodes and 'Q' of every thread.
+string hdaStar(string const initialState, string const goalState, heuristicFunction heuristic, int numThreads, SearchMetrics &metrics);
+
+#endif
@@ -0,0 +1,177 @@
+#include "heuristic.h"
+
+using namespace std;
+
+
+int tablesFor(heuristicFunction hFunction) {
+
+	switch(hFunction){
+		case patternDatabase:
+			return patternTables;
+		case linearConflict:
+			return conflictTables;
+		case walkingDistance:
+			return walkingTables;
+		case misplacedTiles:
+		case manhattanDistance:
+		case noHeuristic:
+			break;
+	};
+
+	return basicTables;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////
+//		
+//	Computes for the heuristic value of a state.
+//		The parameter is an enum used to determine what algorithm to
+//		run - misplaced or mahattan.
+//		Returns the respective 'h cost' value
+//
+////////////////////////////////////////////////////////////////////////
+int heuristicValue(PackedState state, heuristicFunction hFunction, const GoalContext &goal) {
+	
+	int sum=0;
+	int h=0;
+	int numOfMisplacedTiles=0;
+	
+	switch(hFunction){
+		case misplacedTiles:			      	
+			
+			// Count the number of tiles in the wrong place - avoiding the '0' tile 
+			for(int cell = 0; cell < NUM_CELLS; cell++) {
+				int tile = tileAt(state, cell);
+				if((goal.getGoalCell(tile) != cell) && (tile != 0)) {
+					numOfMisplacedTiles++;
+				}
+			}
+			h = numOfMisplacedTiles; 					
+			break;
+		         
+		case manhattanDistance:
+			
+			// loop through the current state board, adding each tile's distance from its goal cell.
+			// the distances are looked up in the goal context's table (which has 0 for the blank).
+			for(int cell = 0; cell < NUM_CELLS; cell++) {
+				sum += goal.getManhattan(tileAt(state, cell), cell);
+			}
+
+			h = sum; 					
+			break;               
+
+		case patternDatabase:
+			// the goal context must have been made with its pattern databases
+			h = goal.getPatternCost(state);
+			break;
+
+		case linearConflict:
+			// Manhattan plus the conflict penalty of every row and column
+			for(int cell = 0; cell < NUM_CELLS; cell++) {
+				sum += goal.getManhattan(tileAt(state, cell), cell);
+			}
+			h = sum + goal.getConflictCost(state);
+			break;
+
+		case walkingDistance:
+			h = goal.getWalkingCost(state);
+			break;
+
+		case noHeuristic:
+			break;
+	};
+	
+	return h;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// A HeuristicCode holds two numbers, one in each half
+static HeuristicCode joinCode(int low, int high) {
+	return (HeuristicCode)(unsigned int)low | ((HeuristicCode)(unsigned int)high << 32);
+}
+
+static void splitCode(HeuristicCode code, int &low, int &high) {
+	low = (int)(code & 0xFFFFFFFF);
+	high = (int)(code >> 32);
+}
+
+
+HeuristicCode heuristicCode(PackedState state, heuristicFunction hFunction, const GoalContext &goal) {
+
+	int low = 0;
+	int high = 0;
+
+	if(hFunction == patternDatabase) {
+		int costs[NUM_PATTERNS];
+		goal.getPatternCosts(state, costs);
+		low = costs[0];
+		high = costs[1];
+	}
+	else if(hFunction == walkingDistance) {
+		goal.getWalkingCodes(state, low, high);
+	}
+
+	return joinCode(low, high);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////
+//		
+//	Change in the heuristic value when 'tile' slides from 'fromCell'
+//		to 'toCell'. Only one tile moves per action, so each
+//		heuristic only looks again at what that tile can change.
+//
+////////////////////////////////////////////////////////////////////////
+int heuristicDelta(PackedState state, int tile, int fromCell, int toCell, HeuristicCode &code,
+                   heuristicFunction hFunction, const GoalContext &goal) {
+
+	int delta = 0;
+
+	switch(hFunction){
+		case misplacedTiles:
+			// -1 if moved into its place, +1 if moved out of it
+			delta = (goal.getGoalCell(tile) != toCell) - (goal.getGoalCell(tile) != fromCell);
+			break;
+
+		case manhattanDistance:
+			// a sum over the tiles, so only the moved tile's distance changes
+			delta = goal.getManhattan(tile, toCell) - goal.getManhattan(tile, fromCell);
+			break;
+
+		case patternDatabase: {
+			// only the database holding the moved tile is looked up (see getPatternDelta())
+			int costs[NUM_PATTERNS];
+			splitCode(code, costs[0], costs[1]);
+			delta = goal.getPatternDelta(state, tile, costs);
+			code = joinCode(costs[0], costs[1]);
+			break;
+		}
+
+		case linearConflict:
+			// Manhattan as above, plus the conflicts of the lines the tile left and entered
+			delta = goal.getManhattan(tile, toCell) - goal.getManhattan(tile, fromCell)
+			        + goal.getConflictDelta(state, fromCell, toCell);
+			break;
+
+		case walkingDistance: {
+			// the row (or column) counts change by the one tile, then the table gives the new distance
+			int rowCode, colCode;
+			splitCode(code, rowCode, colCode);
+			delta = goal.getWalkingDelta(tile, fromCell, toCell, rowCode, colCode);
+			code = joinCode(rowCode, colCode);
+			break;
+		}
+
+		case noHeuristic:
+			break;
+	};
+
+	return delta;
+}
+
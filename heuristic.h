@@ -0,0 +1,34 @@
+#ifndef __HEURISTIC_H__
+#define __HEURISTIC_H__
+
+#include "board.h"
+#include "goal_context.h"
+
+
+enum heuristicFunction{misplacedTiles, manhattanDistance, noHeuristic, patternDatabase, linearConflict, walkingDistance};
+
+
+// What a heuristic keeps about a board besides its value, so a move can update it without looking at
+// the whole board. Walking distance keeps its row code in the low 32 bits and its column code in the
+// high 32, the pattern database the cost of its first pattern in the low 32 and its second in the high
+// 32. The other heuristics keep nothing (0).
+typedef uint64_t HeuristicCode;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Heuristics on a packed board, shared by every search.
+//      tablesFor()      - goal tables (goalTables) the heuristic looks up, for the GoalContext
+//      heuristicValue() - full computation over the board
+//      heuristicCode()  - the code of the board, for the root of a search
+//      heuristicDelta() - change in value after 'tile' slid from 'fromCell' to 'toCell',
+//                         'state' is the board AFTER the move, 'code' that of the board
+//                         before it. 'code' is updated to the board after the move.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+int tablesFor(heuristicFunction hFunction);
+int heuristicValue(PackedState state, heuristicFunction hFunction, const GoalContext &goal);
+HeuristicCode heuristicCode(PackedState state, heuristicFunction hFunction, const GoalContext &goal);
+int heuristicDelta(PackedState state, int tile, int fromCell, int toCell, HeuristicCode &code,
+                   heuristicFunction hFunction, const GoalContext &goal);
+#endif
@@ -0,0 +1,739 @@
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ida_star.h"
+#include "canonical.h"
+#include "solvability.h"
+#include "search_clock.h"
+
+using namespace std;
+
+
+// returned by IdaSearch::search() when the goal has been found
+static const int FOUND = -1;
+
+static const int MIN_GIVEN_AWAY_DEPTH = 10;     // a board is only split for another thread with this many moves left to the bound
+
+class IdaWorkShare;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  State of one IDA* run. There is a single board that is changed in place on the way down
+//  the tree and changed back on the way up, with the heuristic updated incrementally.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class IdaSearch {
+
+private:
+    const GoalContext &goal;
+    heuristicFunction heuristic;
+
+    PackedState state;                      // the board, moved in place
+    char path[MAX_SOLUTION_LENGTH + 1];     // moves taken to reach 'state'
+    const atomic<bool> *cancelled;          // set by another thread once it has found the goal, or NULL
+    IdaWorkShare *share;                    // subtrees of a parallel search, or NULL
+    int id;                                 // the thread's number in 'share'
+
+    bool workWanted();
+    int giveAway(int g, int h, HeuristicCode code, int bound, int prevMove);
+
+public:
+    int numOfStateExpansions;
+    int maxDepth;
+    int numOfLocalLoopsAvoided;
+    int numOfGeneratedNodes;
+    int solutionLength;                     // set when the goal is found
+
+    IdaSearch(PackedState start, const GoalContext &goal, heuristicFunction heuristic, const atomic<bool> *cancelled = NULL,
+              IdaWorkShare *share = NULL, int id = 0)
+        : goal(goal), heuristic(heuristic), state(start), cancelled(cancelled), share(share), id(id), numOfStateExpansions(0),
+          maxDepth(0), numOfLocalLoopsAvoided(0), numOfGeneratedNodes(0), solutionLength(0) {}
+
+    int search(int g, int h, HeuristicCode code, int bound, int prevMove);
+
+    string getPath() {
+        return string(path, solutionLength);
+    }
+
+    // Moves that led from the root of the whole search to 'start', when searching below a board part way down
+    void setPathTo(string const &moves) {
+        moves.copy(path, moves.length());
+    }
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Depth first search below the current board, which is 'g' moves from
+//      the start and has heuristic 'h' (and heuristic code 'code'). Returns FOUND if the goal was
+//      reached within 'bound', otherwise the smallest f-cost that went over
+//      the bound (the bound for the next iteration).
+//
+//      'prevMove' is the move that reached this board (-1 at the root), the
+//      child that would move the blank straight back is never generated.
+//
+//      Gives up and returns INT_MAX once 'cancelled' is set.
+//
+//      In a parallel search, while another thread is out of work, the
+//      children after the first of a board far from the bound are
+//      given to it rather than searched here (see IdaWorkShare).
+//
+///////////////////////////////////////////////////////////////////////////////
+int IdaSearch::search(int g, int h, HeuristicCode code, int bound, int prevMove) {
+
+    int f = g + h;
+    if(f > bound) {
+        return f;
+    }
+    if(cancelled != NULL && cancelled->load(memory_order_relaxed)) {
+        return INT_MAX;
+    }
+    if(state == goal.getGoalState()) {
+        solutionLength = g;
+        return FOUND;
+    }
+
+    numOfStateExpansions++;
+    if(g + 1 > maxDepth) {
+        maxDepth = g + 1;
+    }
+
+    int nextBound = INT_MAX;
+    int blank = blankIndex(state);
+    const BlankMoves &moves = blankMoves[blank];
+
+    bool givingAway = share != NULL && bound - g >= MIN_GIVEN_AWAY_DEPTH && workWanted();
+    bool kept = false;
+
+    for(int i = 0; i < moves.count; i++) {
+
+        // opposite moves are 2 apart in U, R, D, L order
+        if(prevMove >= 0 && moves.move[i] == (prevMove + 2) % 4) {
+            numOfLocalLoopsAvoided++;
+            continue;
+        }
+
+        // make the move in place
+        int cell = moves.cell[i];
+        int tile = tileAt(state, cell);
+        state = slideBlank(state, cell);
+        numOfGeneratedNodes++;
+        HeuristicCode childCode = code;
+        int childH = h + heuristicDelta(state, tile, cell, blank, childCode, heuristic, goal);
+        path[g] = moveLetters[moves.move[i]];
+
+        int result;
+        if(givingAway && kept) {
+            result = giveAway(g + 1, childH, childCode, bound, moves.move[i]);
+        }
+        else {
+            kept = true;
+            result = search(g + 1, childH, childCode, bound, moves.move[i]);
+            if(result == FOUND) {
+                return FOUND;
+            }
+        }
+        if(result < nextBound) {
+            nextBound = result;
+        }
+
+        // undo the move, the tile goes back and the blank returns to 'blank'
+        state = slideBlank(state, blank);
+    }
+
+    return nextBound;
+}
+
+
+// Bound of the first iteration: the start's heuristic, or past the longest solution if the goal
+// can't be reached, so no iteration runs (see solvability.h)
+static int firstBound(PackedState start, int h, const GoalContext &goal) {
+
+    if(!isSolvable(start, goal.getGoalState())) {
+        return MAX_SOLUTION_LENGTH + 1;
+    }
+    return h;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Search Algorithm:  IDA*
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+string idaStar(string const initialState, string const goalState, heuristicFunction heuristic, SearchMetrics &metrics) {
+
+    SearchTime startTime = searchClock();
+    string path = "";
+
+    CanonicalProblem problem(initialState, goalState, tablesFor(heuristic));
+    PackedState start = problem.start;
+    const GoalContext &goal = problem.goal;
+    IdaSearch ida(start, goal, heuristic);
+
+    int h = heuristicValue(start, heuristic, goal);
+    HeuristicCode code = heuristicCode(start, heuristic, goal);
+    int bound = firstBound(start, h, goal);
+
+    // each iteration raises the bound to the lowest f-cost that went over it. With an admissible
+    // heuristic a bound over the longest possible solution means the board can't be solved.
+    while(bound <= MAX_SOLUTION_LENGTH) {
+        int result = ida.search(0, h, code, bound, -1);
+
+        if(result == FOUND) {
+            path = ida.getPath();
+            break;
+        }
+        bound = result;
+    }
+
+    metrics.pathLength = path.length();
+    metrics.numOfStateExpansions = ida.numOfStateExpansions;
+    metrics.maxQLength = ida.maxDepth;
+    metrics.numOfDeletionsFromMiddleOfHeap = 0;
+    metrics.numOfLocalLoopsAvoided = ida.numOfLocalLoopsAvoided;
+    metrics.numOfAttemptedNodeReExpansions = 0;
+    metrics.numOfGeneratedNodes = ida.numOfGeneratedNodes;
+    metrics.peakMemoryBytes = sizeof(IdaSearch);
+    metrics.actualRunningTime = secondsSince(startTime);
+    return path;
+}
+
+
+string idaStar(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic) {
+
+    SearchMetrics metrics;
+    string path = idaStar(initialState, goalState, heuristic, metrics);
+
+    metrics.getCounters(pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap,
+                        numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
+    return path;
+}
+
+
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+static const int TASKS_PER_THREAD = 4;      // the tree is split until there are about this many subtrees per thread
+
+
+// A subtree of one parallel IDA* iteration: the board at its root, and how it was reached
+struct IdaTask {
+    PackedState state;
+    int g;
+    int h;
+    HeuristicCode code;
+    int prevMove;
+    string moves;
+};
+
+
+// Subtrees waiting to be searched, held by one thread. The owner takes from the front, and a thread
+// that has run out takes from the back. Subtrees take far longer to search than the lock is held.
+class IdaTaskDeque {
+
+private:
+    mutex lock;
+    deque<IdaTask> tasks;
+
+public:
+    void push(IdaTask const &task) {
+        lock_guard<mutex> guard(lock);
+        tasks.push_back(task);
+    }
+
+    bool take(IdaTask &task) {
+        lock_guard<mutex> guard(lock);
+        if(tasks.empty()) {
+            return false;
+        }
+        task = tasks.front();
+        tasks.pop_front();
+        return true;
+    }
+
+    bool steal(IdaTask &task) {
+        lock_guard<mutex> guard(lock);
+        if(tasks.empty()) {
+            return false;
+        }
+        task = tasks.back();
+        tasks.pop_back();
+        return true;
+    }
+
+    bool empty() {
+        lock_guard<mutex> guard(lock);
+        return tasks.empty();
+    }
+
+    void clear() {
+        lock_guard<mutex> guard(lock);
+        tasks.clear();
+    }
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  The subtrees of one parallel IDA* iteration not yet searched, a deque per thread. A
+//  thread takes from its own deque, then steals from the others'. A thread that finds
+//  nothing is 'hungry', and while one is, a busy thread with an empty deque gives away the
+//  unexplored siblings of the board it is at to its deque (IdaSearch::giveAway()). So a
+//  thread left with one deep subtree splits it for the others rather than searching it
+//  alone while they wait.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class IdaWorkShare {
+
+private:
+    vector<unique_ptr<IdaTaskDeque> > deques;
+    atomic<int> pending;                    // subtrees handed out and not yet searched to the end
+    atomic<int> hungry;                     // threads with nothing to search
+    atomic<int> peakPending;
+
+public:
+    IdaWorkShare(int numThreads) : pending(0), hungry(0), peakPending(0) {
+        for(int i = 0; i < numThreads; i++) {
+            deques.push_back(unique_ptr<IdaTaskDeque>(new IdaTaskDeque()));
+        }
+    }
+
+    // Deals the first subtrees of an iteration out to the threads in turn
+    void start(vector<IdaTask> const &tasks) {
+        for(size_t i = 0; i < deques.size(); i++) {
+            deques[i]->clear();
+        }
+        pending = tasks.size();
+        for(size_t task = 0; task < tasks.size(); task++) {
+            deques[task % deques.size()]->push(tasks[task]);
+        }
+        if((int)tasks.size() > peakPending) {
+            peakPending = tasks.size();
+        }
+    }
+
+    // True if thread 'id' should give away the rest of the board it is at
+    bool wanted(int id) {
+        return hungry.load(memory_order_relaxed) > 0 && deques[id]->empty();
+    }
+
+    void giveAway(int id, IdaTask const &task) {
+        int now = ++pending;
+        int peak = peakPending.load();
+        while(now > peak && !peakPending.compare_exchange_weak(peak, now)) {
+        }
+        deques[id]->push(task);
+    }
+
+    // The next subtree for thread 'id', waiting while other threads may still give some away.
+    // False once every subtree has been searched, or the goal was found.
+    bool next(int id, IdaTask &task, atomic<bool> const &found) {
+
+        int numThreads = deques.size();
+        bool isHungry = false;
+
+        while(pending.load() > 0 && !found.load(memory_order_relaxed)) {
+
+            // own subtrees first, then the other threads' starting with the next one along
+            bool haveTask = deques[id]->take(task);
+            for(int i = 1; !haveTask && i < numThreads; i++) {
+                haveTask = deques[(id + i) % numThreads]->steal(task);
+            }
+            if(haveTask) {
+                if(isHungry) {
+                    hungry--;
+                }
+                return true;
+            }
+
+            if(!isHungry) {
+                hungry++;
+                isHungry = true;
+            }
+            this_thread::yield();
+        }
+
+        if(isHungry) {
+            hungry--;
+        }
+        return false;
+    }
+
+    // Called once a subtree from next() has been searched, after any of it was given away
+    void finished() {
+        pending--;
+    }
+
+    size_t peakTasks() {
+        return peakPending;
+    }
+};
+
+
+bool IdaSearch::workWanted() {
+    return share->wanted(id);
+}
+
+
+// Hands the child just made (the current board) to the work share instead of searching it, unless
+// it is over the bound. Returns what search() would have without searching any further.
+int IdaSearch::giveAway(int g, int h, HeuristicCode code, int bound, int prevMove) {
+
+    if(g + h > bound) {
+        return g + h;
+    }
+
+    IdaTask task;
+    task.state = state;
+    task.g = g;
+    task.h = h;
+    task.code = code;
+    task.prevMove = prevMove;
+    task.moves = string(path, g);
+    share->giveAway(id, task);
+    return INT_MAX;
+}
+
+
+// Counters and result of one thread, merged after every iteration
+struct IdaThreadResult {
+    int nextBound;
+    int numOfStateExpansions;
+    int maxDepth;
+    int numOfLocalLoopsAvoided;
+    int numOfGeneratedNodes;
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  The threads of one parallel IDA* search. They are started once and kept for the whole
+//  search: iterate() hands them the first subtrees of an iteration (f-cost bound), and
+//  waits until they are all searched, splitting them further through the work share as
+//  threads run out. The first thread to reach the goal sets 'found', which stops the
+//  others. Every solution found within the bound is optimal, so it doesn't matter which
+//  one wins.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class ParallelIdaSearch {
+
+private:
+    const GoalContext &goal;
+    heuristicFunction heuristic;
+    int numThreads;
+
+    IdaWorkShare share;
+    atomic<bool> found;
+    mutex pathLock;
+    vector<thread> pool;
+
+    mutex lock;                             // guards the five below
+    condition_variable started;             // an iteration was started, or the search is over
+    condition_variable finished;            // a thread has finished the iteration
+    int bound;
+    int numOfIterations;
+    int numFinished;                        // threads done with the current iteration
+    bool stopping;
+
+    void run(int id);
+    void searchIteration(int id, int bound, IdaThreadResult &result);
+
+public:
+    string path;                            // set if the goal was found
+    vector<IdaThreadResult> results;        // of the last iteration
+
+    ParallelIdaSearch(const GoalContext &goal, heuristicFunction heuristic, int numThreads);
+    ~ParallelIdaSearch();
+
+    bool iterate(int bound, vector<IdaTask> const &tasks);
+
+    size_t peakTasks() {
+        return share.peakTasks();
+    }
+};
+
+
+ParallelIdaSearch::ParallelIdaSearch(const GoalContext &goal, heuristicFunction heuristic, int numThreads)
+    : goal(goal), heuristic(heuristic), numThreads(numThreads), share(numThreads), found(false), bound(0), numOfIterations(0),
+      numFinished(0), stopping(false), results(numThreads) {
+
+    for(int i = 0; i < numThreads; i++) {
+        pool.push_back(thread(&ParallelIdaSearch::run, this, i));
+    }
+}
+
+
+ParallelIdaSearch::~ParallelIdaSearch() {
+
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    started.notify_all();
+
+    for(int i = 0; i < numThreads; i++) {
+        pool[i].join();
+    }
+}
+
+
+// The loop of one thread: waits for an iteration, searches its share of it, and reports back
+void ParallelIdaSearch::run(int id) {
+
+    int numDone = 0;
+
+    while(true) {
+        int iterationBound;
+        {
+            unique_lock<mutex> guard(lock);
+            started.wait(guard, [this, numDone] { return numOfIterations > numDone || stopping; });
+            if(stopping) {
+                break;
+            }
+            numDone = numOfIterations;
+            iterationBound = bound;
+        }
+
+        searchIteration(id, iterationBound, results[id]);
+
+        {
+            lock_guard<mutex> guard(lock);
+            numFinished++;
+        }
+        finished.notify_one();
+    }
+}
+
+
+void ParallelIdaSearch::searchIteration(int id, int bound, IdaThreadResult &result) {
+
+    result.nextBound = INT_MAX;
+    result.numOfStateExpansions = 0;
+    result.maxDepth = 0;
+    result.numOfLocalLoopsAvoided = 0;
+    result.numOfGeneratedNodes = 0;
+
+    IdaTask root;
+    while(share.next(id, root, found)) {
+
+        IdaSearch ida(root.state, goal, heuristic, &found, &share, id);
+        ida.setPathTo(root.moves);
+
+        int outcome = ida.search(root.g, root.h, root.code, bound, root.prevMove);
+
+        result.numOfStateExpansions += ida.numOfStateExpansions;
+        result.numOfLocalLoopsAvoided += ida.numOfLocalLoopsAvoided;
+        result.numOfGeneratedNodes += ida.numOfGeneratedNodes;
+        if(ida.maxDepth > result.maxDepth) {
+            result.maxDepth = ida.maxDepth;
+        }
+
+        if(outcome == FOUND) {
+            lock_guard<mutex> guard(pathLock);
+            if(!found.load()) {
+                path = ida.getPath();
+                found = true;
+            }
+        }
+        else if(outcome < result.nextBound) {
+            result.nextBound = outcome;
+        }
+        share.finished();
+    }
+}
+
+
+// Runs one iteration on the threads, true if the goal was found
+bool ParallelIdaSearch::iterate(int bound, vector<IdaTask> const &tasks) {
+
+    unique_lock<mutex> guard(lock);
+    share.start(tasks);
+    this->bound = bound;
+    numFinished = 0;
+    numOfIterations++;
+    started.notify_all();
+
+    finished.wait(guard, [this] { return numFinished == numThreads; });
+    return found;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Splits the tree under 'start' for an iteration with 'bound', a level
+//      at a time, until there are 'wanted' subtrees (or the tree runs out).
+//      The children over the bound are left out, with the lowest f-cost of
+//      them kept in 'nextBound'. Returns true, with the path in 'path', if
+//      the goal is one of the boards on the way down.
+//
+///////////////////////////////////////////////////////////////////////////////
+static bool splitTree(PackedState start, int h, int bound, const GoalContext &goal, heuristicFunction heuristic, size_t wanted,
+                      vector<IdaTask> &tasks, int &nextBound, SearchMetrics &metrics, string &path) {
+
+    IdaTask root;
+    root.state = start;
+    root.g = 0;
+    root.h = h;
+    root.code = heuristicCode(start, heuristic, goal);
+    root.prevMove = -1;
+    root.moves = "";
+
+    tasks.clear();
+    if(h <= bound) {
+        tasks.push_back(root);
+    }
+    else {
+        nextBound = h;
+    }
+
+    while(!tasks.empty() && tasks.size() < wanted) {
+
+        vector<IdaTask> next;
+
+        for(size_t t = 0; t < tasks.size(); t++) {
+            IdaTask const &task = tasks[t];
+
+            if(task.state == goal.getGoalState()) {
+                path = task.moves;
+                return true;
+            }
+            metrics.numOfStateExpansions++;
+
+            int blank = blankIndex(task.state);
+            const BlankMoves &moves = blankMoves[blank];
+
+            for(int i = 0; i < moves.count; i++) {
+
+                if(task.prevMove >= 0 && moves.move[i] == (task.prevMove + 2) % 4) {
+                    metrics.numOfLocalLoopsAvoided++;
+                    continue;
+                }
+
+                IdaTask child;
+                int cell = moves.cell[i];
+                int tile = tileAt(task.state, cell);
+                child.state = slideBlank(task.state, cell);
+                metrics.numOfGeneratedNodes++;
+                child.g = task.g + 1;
+                child.code = task.code;
+                child.h = task.h + heuristicDelta(child.state, tile, cell, blank, child.code, heuristic, goal);
+                child.prevMove = moves.move[i];
+                child.moves = task.moves + moveLetters[moves.move[i]];
+
+                if(child.g + child.h > bound) {
+                    if(child.g + child.h < nextBound) {
+                        nextBound = child.g + child.h;
+                    }
+                    continue;
+                }
+                next.push_back(child);
+            }
+        }
+        tasks.swap(next);
+
+        if(tasks.size() * sizeof(IdaTask) > metrics.peakMemoryBytes) {
+            metrics.peakMemoryBytes = tasks.size() * sizeof(IdaTask);
+        }
+    }
+    return false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Search Algorithm:  Parallel IDA*
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+string parallelIdaStar(string const initialState, string const goalState, heuristicFunction heuristic, int numThreads,
+                        SearchMetrics &metrics) {
+
+    SearchTime startTime = searchClock();
+    string path = "";
+
+    metrics.numOfStateExpansions = 0;
+    metrics.maxQLength = 0;
+    metrics.numOfDeletionsFromMiddleOfHeap = 0;
+    metrics.numOfLocalLoopsAvoided = 0;
+    metrics.numOfAttemptedNodeReExpansions = 0;
+    metrics.numOfGeneratedNodes = 0;
+    metrics.peakMemoryBytes = 0;
+
+    if(numThreads <= 0) {
+        numThreads = thread::hardware_concurrency();
+    }
+    if(numThreads < 1) {
+        numThreads = 1;
+    }
+
+    CanonicalProblem problem(initialState, goalState, tablesFor(heuristic));
+    PackedState start = problem.start;
+    const GoalContext &goal = problem.goal;
+
+    int h = heuristicValue(start, heuristic, goal);
+    int bound = firstBound(start, h, goal);
+
+    vector<IdaTask> tasks;
+    ParallelIdaSearch parallel(goal, heuristic, numThreads);
+
+    while(bound <= MAX_SOLUTION_LENGTH) {
+
+        int nextBound = INT_MAX;
+        if(splitTree(start, h, bound, goal, heuristic, numThreads * TASKS_PER_THREAD, tasks, nextBound, metrics, path)) {
+            break;
+        }
+
+        bool found = parallel.iterate(bound, tasks);
+
+        for(int i = 0; i < numThreads; i++) {
+            IdaThreadResult &result = parallel.results[i];
+            metrics.numOfStateExpansions += result.numOfStateExpansions;
+            metrics.numOfLocalLoopsAvoided += result.numOfLocalLoopsAvoided;
+            metrics.numOfGeneratedNodes += result.numOfGeneratedNodes;
+            if(result.maxDepth > metrics.maxQLength) {
+                metrics.maxQLength = result.maxDepth;
+            }
+            if(result.nextBound < nextBound) {
+                nextBound = result.nextBound;
+            }
+        }
+
+        if(found) {
+            path = parallel.path;
+            break;
+        }
+        bound = nextBound;
+    }
+
+    if(parallel.peakTasks() * sizeof(IdaTask) > metrics.peakMemoryBytes) {
+        metrics.peakMemoryBytes = parallel.peakTasks() * sizeof(IdaTask);
+    }
+    metrics.peakMemoryBytes += numThreads * sizeof(IdaSearch);
+    metrics.pathLength = path.length();
+    metrics.actualRunningTime = secondsSince(startTime);
+    return path;
+}
+
+
+string parallelIdaStar(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                        float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                        int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic, int numThreads) {
+
+    SearchMetrics metrics;
+    string path = parallelIdaStar(initialState, goalState, heuristic, numThreads, metrics);
+
+    metrics.getCounters(pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap,
+                        numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
+    return path;
+}
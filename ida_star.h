@@ -0,0 +1,49 @@
+#ifndef __IDA_STAR_H__
+#define __IDA_STAR_H__
+
+#include <string>
+
+#include "heuristic.h"
+#include "search_metrics.h"
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  IDA* (iterative deepening A*). Depth first searches with an increasing f-cost bound,
+//  so memory is only the current path (O(depth)) rather than every generated node.
+//  Has the same counters as aStar_ExpandedList():
+//      maxQLength              - deepest path held at once
+//      numOfLocalLoopsAvoided  - children skipped because they would undo the previous move
+//  there is no 'Q' or expanded list, so the deletion and re-expansion counters stay 0.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+string idaStar(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic);
+
+// The same, handing back every metric. peakMemoryBytes is the board and path held by the search.
+string idaStar(string const initialState, string const goalState, heuristicFunction heuristic, SearchMetrics &metrics);
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  IDA* on 'numThreads' threads (0 = one per core), started once for the whole search.
+//  Each iteration splits the tree a few levels down into a few subtrees per thread, which
+//  the threads search with work stealing: each takes from its own share first, then from
+//  the others', and while a thread has nothing to take a busy one gives away the unexplored
+//  siblings of the board it is at. Once one thread finds the goal the others stop. Memory
+//  stays O(depth) per thread. The counters are added up over the threads (maxQLength is
+//  the deepest path of any of them).
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+string parallelIdaStar(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                        float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                        int &numOfAttemptedNodeReExpansions, heuristicFunction heuristic, int numThreads = 0);
+
+// The same, handing back every metric. peakMemoryBytes is the board and path held by each thread, and the subtrees.
+string parallelIdaStar(string const initialState, string const goalState, heuristicFunction heuristic, int numThreads,
+                        SearchMetrics &metrics);
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef __INDEXED_HEAP_H__
+#define __INDEXED_HEAP_H__
+
+#include <vector>
+
+#include "permutation.h"
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Binary min-heap that also knows which slot each state is in, so a state already in 'Q'
+//  can be found in O(1) and given a cheaper cost in O(log n) (decrease-key), instead of a
+//  linear find_if() and a make_heap() over the whole of 'Q'.
+//
+//      T       - element type, a pointer to a node with getState() returning the PackedState
+//      Compare - same comparators as used with push_heap()/pop_heap(), i.e. returns true
+//                when the first element should be BELOW the second one in the heap
+//
+//  The slot of each state is kept in an array indexed by its permutation rank.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T, typename Compare>
+class IndexedHeap {
+
+private:
+    vector<T> heap;
+    vector<int> slotOf;         // heap slot of each state by rank, NOT_IN_Q if not in the heap
+    Compare compare;
+
+    // Puts element 'item' into 'slot' and records where it went
+    void place(int slot, T &item) {
+        heap[slot] = item;
+        slotOf[rankState(item->getState())] = slot;
+    }
+
+    void siftUp(int slot) {
+        T item = heap[slot];
+
+        while(slot > 0) {
+            int parent = (slot - 1) / 2;
+            if(!compare(heap[parent], item)) {
+                break;
+            }
+            place(slot, heap[parent]);
+            slot = parent;
+        }
+        place(slot, item);
+    }
+
+    void siftDown(int slot) {
+        T item = heap[slot];
+        int count = heap.size();
+
+        while(true) {
+            int child = 2 * slot + 1;
+            if(child >= count) {
+                break;
+            }
+            // pick the better of the two children
+            if(child + 1 < count && compare(heap[child], heap[child + 1])) {
+                child++;
+            }
+            if(!compare(item, heap[child])) {
+                break;
+            }
+            place(slot, heap[child]);
+            slot = child;
+        }
+        place(slot, item);
+    }
+
+public:
+    static const int NOT_IN_Q = -1;
+
+    IndexedHeap() : slotOf(NUM_PERMUTATIONS, NOT_IN_Q) {}
+
+    bool empty() {
+        return heap.empty();
+    }
+
+    int size() {
+        return heap.size();
+    }
+
+    // Empties the heap. Only the slots still in use need resetting, popped ones are reset by pop()
+    void clear() {
+        for(size_t i = 0; i < heap.size(); i++) {
+            slotOf[rankState(heap[i]->getState())] = NOT_IN_Q;
+        }
+        heap.clear();
+    }
+
+    // Returns the slot holding 'state', or NOT_IN_Q
+    int find(PackedState state) {
+        return slotOf[rankState(state)];
+    }
+
+    T &at(int slot) {
+        return heap[slot];
+    }
+
+    void push(T &item) {
+        heap.push_back(item);
+        siftUp(heap.size() - 1);
+    }
+
+    // Removes and returns the lowest cost element
+    T pop() {
+        T top = heap[0];
+        slotOf[rankState(top->getState())] = NOT_IN_Q;
+
+        T last = heap.back();
+        heap.pop_back();
+
+        if(!heap.empty()) {
+            heap[0] = last;
+            siftDown(0);
+        }
+        return top;
+    }
+
+    // Replaces the element in 'slot' with a lower cost version of the same state
+    void decreaseKey(int slot, T &item) {
+        heap[slot] = item;
+        siftUp(slot);
+    }
+};
+
+// NOT_IN_Q is passed by reference (e.g. to vector), so it needs a definition
+template <typename T, typename Compare>
+const int IndexedHeap<T, Compare>::NOT_IN_Q;
+
+#endif
@@ -16,30 +16,42 @@
 #if defined __unix__ || defined __APPLE__
     #include <stdio.h>
     #include <stdlib.h>
+    #include <climits>
     #include <sstream>
     #include <iostream>
     #include <iomanip>
     #include <algorithm> //used by transform - to lower case
     #include <exception>
     #include <chrono>
+    #include <fstream>
+    #ifndef HEADLESS
     #include <graphics.h>
+    #endif
 
     #include "algorithm.h"
+    #include "batch_runner.h"
+    #include "search_api.h"
 
 #elif defined __WIN32__
 
     #include <windows.h>
     #include <stdio.h>
     #include <stdlib.h>
+    #include <climits>
     #include <sstream>
     #include <iostream>
     #include <iomanip>
     #include <algorithm> //used by transform - to lower case
     #include <exception>
     #include <chrono>
+    #include <fstream>
 
+    #ifndef HEADLESS
     #include "graphics.h"
+    #endif
     #include "algorithm.h"
+    #include "batch_runner.h"
+    #include "search_api.h"
 
 #endif
 
@@ -52,6 +64,10 @@ string goalState = string("123456780");
 
 int g_local_loops_avoided;
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+// Drawing and animation, left out of the headless build (compiled with -DHEADLESS) that has no graphics library
+#ifndef HEADLESS
+
 #define OUTPUT_LENGTH 2 /* Length of output string. */
 
 const int HEIGHT = 400; /**< Height of board for rendering in pixels. */
@@ -259,7 +275,8 @@ void AnimateSolution(string const initialState, string const goalState, string p
         cout << "Plan of action = " << path << endl;
     }
     
-    Puzzle *p = new Puzzle(initialState, goalState);
+    GoalContext goal(goalState);
+    Puzzle *p = new Puzzle(initialState, goal);
     Puzzle *nextState=NULL;
     
     string strState;
@@ -301,280 +318,192 @@ void AnimateSolution(string const initialState, string const goalState, string p
 }
 
 
-///////////////////////////////////////////////////////////////////////////////////////////////
-void run_all_experiments() {
+// Opens the window. Only animate_run needs it, single and batch runs work without a display.
+void open_graphics_window() {
 
-    int num_of_init_states = sizeof(list_of_initialStates) / sizeof(list_of_initialStates[0]);
-
-    int pathLength = 0;
-    // int depth = 0;
-    int numOfStateExpansions = 0;
-    int maxQLength = 0;
-    int numOfDeletionsFromMiddleOfHeap = 0;
-    int numOfLocalLoopsAvoided = 0;
-    int numOfAttemptedNodeReExpansions = 0;
-    float actualRunningTime = 0.0;
-
-    string initialState;
+#if defined __unix__ || defined __APPLE__
+    // init graphics
+    int GraphDriver=DETECT,GraphMode;
+    initgraph( &GraphDriver, &GraphMode, const_cast<char*>("") ); // Start Window
 
-    std::cout << "ALGORITHM,               INIT_STATE,            GOAL_STATE,       PATH_LENGTH,     STATE_EXPANSIONS,  MAX_QLENGTH,  RUNNING_TIME,  DELETIONS_MIDDLE_HEAP, LOCAL_LOOPS_AVOIDED, ATTEMPTED_REEXPANSIONS,   PATH" << endl;
+#elif defined __WIN32__    
+    // init graphics
+    int graphDriver = 0;
+    int graphMode = 0;
+    initgraph(&graphDriver, &graphMode, "", WIDTH, HEIGHT);   
+#endif
+}
 
-    //---   Runs the UC algorithm
-    for (int j = 0; j < num_of_init_states; j++) {
+#endif
+//////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        initialState = list_of_initialStates[j];
-
-        string path;
-        path.clear();
-        pathLength = 0;
-        // depth = 0;
-        numOfStateExpansions = 0;
-        maxQLength = 0;
-        numOfDeletionsFromMiddleOfHeap = 0;
-        numOfLocalLoopsAvoided = 0;
-        numOfAttemptedNodeReExpansions = 0;
-        actualRunningTime = 0.0;
-        path = uc_explist(initialState, goalState, pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap, numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
-
-
-        std::cout << setw(21) << "uniform_cost_search";
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << initialState;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << goalState;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << pathLength;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << numOfStateExpansions;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << maxQLength;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << actualRunningTime;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << numOfDeletionsFromMiddleOfHeap;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << numOfLocalLoopsAvoided;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << numOfAttemptedNodeReExpansions;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << path << endl;
-
-
-    } //End - For loop
-    //---
-    for (int j = 0; j < num_of_init_states; j++) {
 
-        initialState = list_of_initialStates[j];
-
-        string path;
-        path.clear();
-        pathLength = 0;
-        // depth = 0;
-        numOfStateExpansions = 0;
-        maxQLength = 0;
-        numOfDeletionsFromMiddleOfHeap = 0;
-        numOfLocalLoopsAvoided = 0;
-        numOfAttemptedNodeReExpansions = 0;
-        actualRunningTime = 0.0;
-        path = aStar_ExpandedList(initialState, goalState, pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap, numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions, misplacedTiles);
-
-                                  
-        std::cout << setw(21) << "astar_misplacedtiles";
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << initialState;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << goalState;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << pathLength;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << numOfStateExpansions;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << maxQLength;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << actualRunningTime;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << numOfDeletionsFromMiddleOfHeap;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << numOfLocalLoopsAvoided;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << numOfAttemptedNodeReExpansions;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << path << endl;
-
-
-     } //End - For loop
-    //---
-    for (int j = 0; j < num_of_init_states; j++) {
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Prints each better path ARA* finds while it runs
+void report_anytime_path(string const &path, float bound) {
+    cout << endl << "  improved path, length " << path.length() << ", at most " << setprecision(3) << bound << " x optimal: " << path;
+}
 
-        initialState = list_of_initialStates[j];
-
-        string path;
-        path.clear();
-        pathLength = 0;
-        // depth = 0;
-        numOfStateExpansions = 0;
-        maxQLength = 0;
-        numOfDeletionsFromMiddleOfHeap = 0;
-        numOfLocalLoopsAvoided = 0;
-        numOfAttemptedNodeReExpansions = 0;
-        actualRunningTime = 0.0;
-        path = aStar_ExpandedList(initialState, goalState, pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap, numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions, manhattanDistance);
-
-                                  
-        std::cout << setw(21) << "astar_manhattan";
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << initialState;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << goalState;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << pathLength;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << numOfStateExpansions;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << maxQLength;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << actualRunningTime;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << numOfDeletionsFromMiddleOfHeap;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << numOfLocalLoopsAvoided;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << numOfAttemptedNodeReExpansions;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << path << endl;
-
-
-    } //End - For loop
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Sets what the optional 5th argument gives for the algorithm of 'request': the weight of weighted A* (at least 1),
+// the time budget of ARA* in seconds (more than 0) or the number of threads of HDA* and parallel IDA* (0 = one per
+// core). Returns false if the argument is not all a number (a whole one for threads) or is out of range. Other
+// algorithms ignore it.
+bool set_optional_argument(char const *argument, SearchRequest &request) {
+
+    char *end;
+
+    if (request.algorithm == hdaStarSearch || request.algorithm == parallelIdaStarSearch) {
+        long numThreads = strtol(argument, &end, 10);
+        if (end == argument || *end != '\0' || numThreads < 0 || numThreads > INT_MAX) return false;
+        request.numThreads = numThreads;
+    }
+    else if (request.algorithm == weightedAStarSearch || request.algorithm == anytimeAStarSearch) {
+        double value = strtod(argument, &end);
+        if (end == argument || *end != '\0') return false;
+
+        // written so that NaN fails too
+        if (request.algorithm == weightedAStarSearch) {
+            if (!(value >= 1.0)) return false;
+            request.weight = value;
+        } else {
+            if (!(value > 0.0)) return false;
+            request.timeBudget = value;
+        }
+    }
+    return true;
 }
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
-void run_uc_experiments() {
+// Number of the batch initial states the goal can't be reached from
+int count_unsolvable_states() {
 
     int num_of_init_states = sizeof(list_of_initialStates) / sizeof(list_of_initialStates[0]);
-
-    int pathLength = 0;
-    // int depth = 0;
-    int numOfStateExpansions = 0;
-    int maxQLength = 0;
-    int numOfDeletionsFromMiddleOfHeap = 0;
-    int numOfLocalLoopsAvoided = 0;
-    int numOfAttemptedNodeReExpansions = 0;
-    float actualRunningTime = 0.0;
-
-    string initialState;
-
-    std::cout << "ALGORITHM,               INIT_STATE,            GOAL_STATE,       PATH_LENGTH,     STATE_EXPANSIONS,  MAX_QLENGTH,  RUNNING_TIME,  DELETIONS_MIDDLE_HEAP, LOCAL_LOOPS_AVOIDED, ATTEMPTED_REEXPANSIONS,   PATH" << endl;
+    int numOfUnsolvable = 0;
 
     for (int j = 0; j < num_of_init_states; j++) {
+        if (!isSolvable(packBoard(list_of_initialStates[j]), packBoard(goalState))) {
+            numOfUnsolvable++;
+        }
+    }
+    return numOfUnsolvable;
+}
 
-        initialState = list_of_initialStates[j];
 
-        string path;
-        path.clear();
-        pathLength = 0;
-        // depth = 0;
-        numOfStateExpansions = 0;
-        maxQLength = 0;
-        numOfDeletionsFromMiddleOfHeap = 0;
-        numOfLocalLoopsAvoided = 0;
-        numOfAttemptedNodeReExpansions = 0;
-        actualRunningTime = 0.0;
-        path = uc_explist(initialState, goalState, pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap, numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Name of each batch algorithm in the output
+string batch_label(string const &algorithm) {
 
+    if (algorithm == "uc_explist") return "uniform_cost_search";
+    if (algorithm == "astar_explist_misplacedtiles") return "astar_misplacedtiles";
+    if (algorithm == "astar_explist_manhattan") return "astar_manhattan";
+    return algorithm;
+}
 
-        std::cout << setw(16) << "uniform_cost_search";
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << initialState;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << goalState;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << pathLength;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(13) << "," << numOfStateExpansions;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << maxQLength;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << actualRunningTime;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << numOfDeletionsFromMiddleOfHeap;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(20) << "," << numOfLocalLoopsAvoided;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << numOfAttemptedNodeReExpansions;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << path << endl;
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+// One job for each of the batch initial states, solved with 'algorithm'
+void add_batch_jobs(vector<BatchJob> &jobs, string const &algorithm) {
 
-    } //End - For loop
+    int num_of_init_states = sizeof(list_of_initialStates) / sizeof(list_of_initialStates[0]);
 
+    for (int j = 0; j < num_of_init_states; j++) {
+        BatchJob job;
+        job.algorithm = algorithm;
+        job.initialState = list_of_initialStates[j];
+        job.goalState = goalState;
+        jobs.push_back(job);
+    }
 }
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
-void run_astar_manhattan_experiments() {
-
-    int num_of_init_states = sizeof(list_of_initialStates) / sizeof(list_of_initialStates[0]);
+// Prints a result row of run_all_experiments()
+void print_all_experiments_result(BatchJob const &job, BatchResult const &result) {
+
+    std::cout << setw(21) << batch_label(job.algorithm);
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << job.initialState;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << job.goalState;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << result.pathLength;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << result.numOfStateExpansions;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << result.maxQLength;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << result.actualRunningTime;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << result.numOfDeletionsFromMiddleOfHeap;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << result.numOfLocalLoopsAvoided;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << result.numOfAttemptedNodeReExpansions;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << result.path << endl;
+}
 
-    int pathLength = 0;
-    // int depth = 0;
-    int numOfStateExpansions = 0;
-    int maxQLength = 0;
-    int numOfDeletionsFromMiddleOfHeap = 0;
-    int numOfLocalLoopsAvoided = 0;
-    int numOfAttemptedNodeReExpansions = 0;
-    float actualRunningTime = 0.0;
 
-    string initialState; 
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Prints a result row of the single algorithm batch runs
+void print_experiment_result(BatchJob const &job, BatchResult const &result) {
+
+    std::cout << setw(16) << batch_label(job.algorithm);
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << job.initialState;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << job.goalState;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << result.pathLength;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(13) << "," << result.numOfStateExpansions;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << result.maxQLength;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << result.actualRunningTime;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << result.numOfDeletionsFromMiddleOfHeap;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(20) << "," << result.numOfLocalLoopsAvoided;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << result.numOfAttemptedNodeReExpansions;
+    std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << result.path << endl;
+}
 
-    std::cout << "ALGORITHM,               INIT_STATE,            GOAL_STATE,       PATH_LENGTH,     STATE_EXPANSIONS,  MAX_QLENGTH,  RUNNING_TIME,  DELETIONS_MIDDLE_HEAP, LOCAL_LOOPS_AVOIDED, ATTEMPTED_REEXPANSIONS,   PATH" << endl;
 
-    for (int j = 0; j < num_of_init_states; j++) {
+///////////////////////////////////////////////////////////////////////////////////////////////
+// The batch runs below solve their initial states on every core (batch_runner.cpp), and print
+// the rows in the same order as if they were solved one after the other.
+void run_all_experiments() {
 
-            initialState = list_of_initialStates[j];
+    vector<BatchJob> jobs;
+    add_batch_jobs(jobs, "uc_explist");
+    add_batch_jobs(jobs, "astar_explist_misplacedtiles");
+    add_batch_jobs(jobs, "astar_explist_manhattan");
 
-            string path;
-            path.clear();
-            pathLength = 0;
-            // depth = 0;
-            numOfStateExpansions = 0;
-            maxQLength = 0;
-            numOfDeletionsFromMiddleOfHeap = 0;
-            numOfLocalLoopsAvoided = 0;
-            numOfAttemptedNodeReExpansions = 0;
-            actualRunningTime = 0.0;
-            path = aStar_ExpandedList(initialState, goalState, pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap, numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions, manhattanDistance);
+    std::cout << "ALGORITHM,               INIT_STATE,            GOAL_STATE,       PATH_LENGTH,     STATE_EXPANSIONS,  MAX_QLENGTH,  RUNNING_TIME,  DELETIONS_MIDDLE_HEAP, LOCAL_LOOPS_AVOIDED, ATTEMPTED_REEXPANSIONS,   PATH" << endl;
 
-            
-            std::cout << setw(16) << "astar_manhattan";
-            std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << initialState;
-            std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << goalState;
-            std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << pathLength;
-            std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(13) << "," << numOfStateExpansions;
-            std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << maxQLength;
-            std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << actualRunningTime;
-            std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << numOfDeletionsFromMiddleOfHeap;
-            std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(20) << "," << numOfLocalLoopsAvoided;
-            std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << numOfAttemptedNodeReExpansions;
-            std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << path << endl;
-            
+    runBatch(jobs, 0, print_all_experiments_result);
 
-    } //End - For loop
+    std::cout << "Unsolvable inputs (turned away before searching): " << count_unsolvable_states() << endl;
 
 }
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
-void run_astar_misplaced_tiles_experiments() {
-
-    int num_of_init_states = sizeof(list_of_initialStates) / sizeof(list_of_initialStates[0]);
-
-    int pathLength = 0;
-    // int depth = 0;
-    int numOfStateExpansions = 0;
-    int maxQLength = 0;
-    int numOfDeletionsFromMiddleOfHeap = 0;
-    int numOfLocalLoopsAvoided = 0;
-    int numOfAttemptedNodeReExpansions = 0;
-    float actualRunningTime = 0.0;
+void run_experiments(string const &algorithm) {
 
-    string initialState;
+    vector<BatchJob> jobs;
+    add_batch_jobs(jobs, algorithm);
 
     std::cout << "ALGORITHM,               INIT_STATE,            GOAL_STATE,       PATH_LENGTH,     STATE_EXPANSIONS,  MAX_QLENGTH,  RUNNING_TIME,  DELETIONS_MIDDLE_HEAP, LOCAL_LOOPS_AVOIDED, ATTEMPTED_REEXPANSIONS,   PATH" << endl;
 
-    for (int j = 0; j < num_of_init_states; j++) {
+    runBatch(jobs, 0, print_experiment_result);
 
-        initialState = list_of_initialStates[j];
+    std::cout << "Unsolvable inputs (turned away before searching): " << count_unsolvable_states() << endl;
 
-        string path;
-        path.clear();
-        pathLength = 0;
-        // depth = 0;
-        numOfStateExpansions = 0;
-        maxQLength = 0;
-        numOfDeletionsFromMiddleOfHeap = 0;
-        numOfLocalLoopsAvoided = 0;
-        numOfAttemptedNodeReExpansions = 0;
-        actualRunningTime = 0.0;
-        path = aStar_ExpandedList(initialState, goalState, pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap, numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions, misplacedTiles);
+}
 
 
-        std::cout << setw(16) << "astar_misplacedtiles";
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << initialState;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << goalState;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(10) << "," << pathLength;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(13) << "," << numOfStateExpansions;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << maxQLength;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << actualRunningTime;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << numOfDeletionsFromMiddleOfHeap;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(20) << "," << numOfLocalLoopsAvoided;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << numOfAttemptedNodeReExpansions;
-        std::cout << setprecision(6) << std::setfill(' ') << std::fixed << std::right << ' ' << setw(15) << "," << path << endl;
+///////////////////////////////////////////////////////////////////////////////////////////////
+void run_uc_experiments() {
+    run_experiments("uc_explist");
+}
+
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+void run_astar_manhattan_experiments() {
+    run_experiments("astar_explist_manhattan");
+}
 
-    } //End - For loop
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+void run_astar_misplaced_tiles_experiments() {
+    run_experiments("astar_explist_misplacedtiles");
 }
 
 
@@ -586,14 +515,13 @@ void run_astar_misplaced_tiles_experiments() {
 /////////////////////////////////////////////////////////////////////////////////////
 
 int main( int argc, char* argv[] ){
-   
-    string path;
 
 	if(argc < 3){
         cout << "<< SEARCH ALGORITHMS >>" << endl;
 		cout << "please include missing parameters." << endl;
         cout << "SYNTAX #1: search.exe <TYPE_OF_RUN = \"batch_run\" or \"single_run\" or \"animate_run\"> ALGORITHM_NAME \"INITIAL STATE\" \"GOAL STATE\" " << endl;
         cout << "SYNTAX #2: search.exe <TYPE_OF_RUN = \"batch_run\"> ALGORITHM_NAME" << endl;
+        cout << "SYNTAX #3: search.exe <TYPE_OF_RUN = \"stream_run\"> ALGORITHM_NAME [\"INPUT FILE\", default stdin]" << endl;
 		exit(0);
 	}
     
@@ -603,7 +531,7 @@ int main( int argc, char* argv[] ){
     string initialState;              
     string goalState;
 
-    if (argc > 3) {
+    if (argc > 4) {
         initialState = string(argv[3]);
         goalState = string(argv[4]);
     }
@@ -611,25 +539,79 @@ int main( int argc, char* argv[] ){
     std::transform(typeOfRun.begin(), typeOfRun.end(), typeOfRun.begin(), ::tolower);
     std::transform(algorithmSelected.begin(), algorithmSelected.end(), algorithmSelected.begin(), ::tolower);
     
+    // generates the pattern database files for a goal (given in place of the algorithm name), no graphics needed.
+    // The searches use the standard goal with the same blank cell, so those are the tables saved.
+    if (typeOfRun == "build_pdb") {
+        const GoalContext &goal = canonicalGoalContext(GoalRelabeling(algorithmSelected).getBlank(), patternTables);
+        if (goal.savePatterns()) {
+            cout << "Pattern databases for " << algorithmSelected << " saved." << endl;
+        } else {
+            cout << "Could not save the pattern databases for " << algorithmSelected << "." << endl;
+        }
+        exit(0);
+    }
 
-	int pathLength=0;                     
-    int numOfStateExpansions=0;	
-	int maxQLength=0;
-    int numOfDeletionsFromMiddleOfHeap=0;
-    int numOfLocalLoopsAvoided=0;
-    int numOfAttemptedNodeReExpansions=0;
-    float actualRunningTime=0.0;	
-	
-#if defined __unix__ || defined __APPLE__
-    // init graphics
-    int GraphDriver=DETECT,GraphMode;
-    initgraph( &GraphDriver, &GraphMode, const_cast<char*>("") ); // Start Window
+    // solves the "initial,goal[,algorithm]" records of a file (or stdin, if there is no file or it is "-") on every
+    // core, writing a result line for each as it is done. ALGORITHM_NAME is used for records that don't name one.
+    if (typeOfRun == "stream_run") {
+        long long numOfRecords;
 
-#elif defined __WIN32__    
-    // init graphics
-    int graphDriver = 0;
-    int graphMode = 0;
-    initgraph(&graphDriver, &graphMode, "", WIDTH, HEIGHT);   
+        if (argc > 3 && string(argv[3]) != "-") {
+            ifstream input(argv[3]);
+            if (!input) {
+                cout << "Could not open " << argv[3] << "." << endl;
+                exit(0);
+            }
+            numOfRecords = runBatchStream(input, cout, algorithmSelected);
+        } else {
+            numOfRecords = runBatchStream(cin, cout, algorithmSelected);
+        }
+
+        cerr << numOfRecords << " records solved." << endl;
+        exit(0);
+    }
+
+
+    // the algorithm name, and the optional 5th argument: the weight of weighted A*, the time budget of ARA* in seconds,
+    // or the number of threads of HDA* and parallel IDA*
+    SearchRequest request(initialState, goalState);
+    SearchResult result;
+    result.status = noSolutionFound;
+
+    if (((typeOfRun == "single_run") || (typeOfRun == "animate_run")) && argc > 4) {
+        if (!requestNamed(algorithmSelected, request)) {
+            cout << "\"" << algorithmSelected << "\" is not an algorithm name, e.g. \"astar_explist_manhattan\"." << endl;
+            exit(0);
+        }
+        if (argc > 5 && !set_optional_argument(argv[5], request)) {
+            cout << "<< SEARCH ALGORITHMS >>" << endl;
+            cout << "\"" << argv[5] << "\" is not a valid 5th argument for " << algorithmSelected << "." << endl;
+            cout << "SYNTAX #1: search.exe <TYPE_OF_RUN = \"single_run\" or \"animate_run\"> ALGORITHM_NAME \"INITIAL STATE\" \"GOAL STATE\" [OPTION]" << endl;
+            cout << "OPTION: wastar_manhattan WEIGHT (1 or more), arastar_manhattan SECONDS (more than 0)," << endl;
+            cout << "        hdastar_<heuristic> or pidastar_<heuristic> THREADS (0 or more, 0 = one per core)" << endl;
+            exit(0);
+        }
+        request.report = report_anytime_path;
+    }
+
+    // the boards are packed as given from here on, so anything that is not one (a tile missing or twice, a
+    // wrong length) is turned away before the window opens or a search runs
+    if (((typeOfRun == "single_run") || (typeOfRun == "animate_run")) && argc > 4
+        && (!isBoard(initialState) || !isBoard(goalState))) {
+        cout << "\"" << initialState << "\" and \"" << goalState << "\" must both be the tiles 0-8 in some order, e.g. \"123456780\"." << endl;
+        exit(0);
+    }
+
+#ifdef HEADLESS
+    if (typeOfRun == "animate_run") {
+        cout << "animate_run needs the graphics build (\"search\"), this is the headless build." << endl;
+        exit(0);
+    }
+#else
+    // the window is only opened when there is something to animate
+    if (typeOfRun == "animate_run") {
+        open_graphics_window();
+    }
 #endif
 
 	
@@ -644,38 +626,9 @@ try{
         }
         //---
         cout << endl << "============================================<< EXPERIMENT RESULTS >>============================================" << endl;
+        cout << setw(31) << std::left << algorithmSelected;
 
-        if (algorithmSelected == "uc_explist") {
-            cout << setw(31) << std::left << "1) uc_explist";
-
-
-        }
-        else if (algorithmSelected == "astar_explist_misplacedtiles") {
-            cout << setw(31) << std::left << "2) astar_explist_misplacedtiles";
-
-        }
-        else if (algorithmSelected == "astar_explist_manhattan") {
-            cout << setw(31) << std::left << "3) astar_explist_manhattan";
-        }
-        //---
-
-        if (algorithmSelected == "uc_explist") {
-
-            path = uc_explist(initialState, goalState, pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap, numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
-
-        }
-       
-        else if (algorithmSelected == "astar_explist_misplacedtiles") {
-
-            path = aStar_ExpandedList(initialState, goalState, pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap, numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions, misplacedTiles);
-
-        }
-        else if (algorithmSelected == "astar_explist_manhattan") {
-
-            
-            path = aStar_ExpandedList(initialState, goalState, pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap,numOfLocalLoopsAvoided ,numOfAttemptedNodeReExpansions, manhattanDistance);
-
-        }
+        result = solve(request);
 
     } else if(typeOfRun == "batch_run") {
 
@@ -691,6 +644,11 @@ try{
 
             run_astar_manhattan_experiments();
 
+        }else if (algorithmSelected == "uc_explist_bucket" || algorithmSelected == "astar_explist_manhattan_bucket") {
+
+            // the same experiments with the bucket queue, to compare against the heap runs above
+            run_experiments(algorithmSelected);
+
         }else if (algorithmSelected == "all") {
             using std::chrono::system_clock;
             system_clock::time_point start;             
@@ -721,32 +679,38 @@ catch(exception &e){
 
     }
     else if ((typeOfRun == "single_run") || (typeOfRun == "animate_run") ){
-        if (pathLength == 0) cout << "\n\n*---- NO SOLUTION found. (Q is empty!) ----*" << endl;
+        SearchMetrics const &metrics = result.metrics;
+
+        if (result.status == unsolvable) cout << "\n\n*---- UNSOLVABLE. (start and goal parity differ, no search run) ----*" << endl;
+        else if (result.status == noSolutionFound) cout << "\n\n*---- NO SOLUTION found. (Q is empty!) ----*" << endl;
 
         cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << endl << endl << "Initial State:" << std::fixed << ' ' << setw(12) << initialState << endl;
         cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << "Goal State:" << std::fixed << ' ' << setw(12) << goalState << endl;
-        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << endl << "Path Length:" << std::fixed << ' ' << setw(12) << pathLength << endl;
-        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << "Num Of State Expansions:" << std::fixed << ' ' << setw(12) << numOfStateExpansions << endl;
-        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << "Max Q Length:" << std::fixed << ' ' << setw(12) << maxQLength << endl;
-        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << "Actual Running Time:" << std::fixed << ' ' << setprecision(6) << setw(12) << actualRunningTime << endl;
+        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << endl << "Path Length:" << std::fixed << ' ' << setw(12) << metrics.pathLength << endl;
+        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << "Num Of State Expansions:" << std::fixed << ' ' << setw(12) << metrics.numOfStateExpansions << endl;
+        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << "Max Q Length:" << std::fixed << ' ' << setw(12) << metrics.maxQLength << endl;
+        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << "Actual Running Time:" << std::fixed << ' ' << setprecision(6) << setw(12) << metrics.actualRunningTime << endl;
 
-        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << "Num of Deletions from MiddleOfHeap:" << std::fixed << ' ' << setprecision(6) << setw(12) << numOfDeletionsFromMiddleOfHeap << endl;
-        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << "Num of Attempted Node ReExpansions:" << std::fixed << ' ' << setprecision(6) << setw(12) << numOfAttemptedNodeReExpansions << endl;
+        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << "Num of Deletions from MiddleOfHeap:" << std::fixed << ' ' << setprecision(6) << setw(12) << metrics.numOfDeletionsFromMiddleOfHeap << endl;
+        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << "Num of Attempted Node ReExpansions:" << std::fixed << ' ' << setprecision(6) << setw(12) << metrics.numOfAttemptedNodeReExpansions << endl;
+        cout << setprecision(6) << setw(25) << std::setfill(' ') << std::right << "Suboptimality Bound:" << std::fixed << ' ' << setprecision(6) << setw(12) << metrics.suboptimalityBound << endl;
 
 
         cout << "================================================================================================================" << endl << endl;
 
     }  
     
+#ifndef HEADLESS
     if(typeOfRun == "animate_run"){
-        if (pathLength == 0) cout << "\n\n*---- NO SOLUTION found. (Q is empty!) ----*" << endl;
+        if (result.status == noSolutionFound) cout << "\n\n*---- NO SOLUTION found. (Q is empty!) ----*" << endl;
 
-        if (path != "") {            
-            AnimateSolution(initialState, goalState, path);            
+        if (result.path != "") {
+            AnimateSolution(initialState, goalState, result.path);
         }
+
+        closegraph();
 	}
-    
-    closegraph();
+#endif
     
     // Show that we have exited without an error. 
     return 0;
@@ -0,0 +1,72 @@
+#ifndef __NODE_ARENA_H__
+#define __NODE_ARENA_H__
+
+#include <new>
+#include <vector>
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Bump allocator for search nodes. Memory is taken in chunks that are never moved (so the
+//  pointers 'Q' holds stay valid) and are kept between searches. Allocating is a pointer
+//  bump, and reset() frees every node of a search in O(1).
+//
+//  T must be trivially destructible, as no destructors are run on reset().
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+class NodeArena {
+
+private:
+    static const int CHUNK_SIZE = 4096;     // nodes per chunk
+
+    vector<T *> chunks;
+    int chunk;                              // chunk currently being filled
+    int used;                               // nodes used in that chunk
+
+public:
+    NodeArena() : chunk(0), used(0) {}
+
+    // the chunks are owned, so a copy would free them twice
+    NodeArena(const NodeArena &) = delete;
+    NodeArena &operator=(const NodeArena &) = delete;
+
+    ~NodeArena() {
+        for(size_t i = 0; i < chunks.size(); i++) {
+            ::operator delete(chunks[i]);
+        }
+    }
+
+    // Copies 'node' into the arena and returns the arena's copy
+    T *allocate(const T &node) {
+        if(used == CHUNK_SIZE) {
+            chunk++;
+            used = 0;
+        }
+        if(chunk == (int)chunks.size()) {
+            chunks.push_back(static_cast<T *>(::operator new(CHUNK_SIZE * sizeof(T))));
+        }
+
+        return new (chunks[chunk] + used++) T(node);
+    }
+
+    // Gives back the most recent allocation, e.g. a child that was not put into 'Q'
+    void releaseLast() {
+        used--;
+    }
+
+    // Memory taken by the nodes allocated so far
+    size_t bytesUsed() {
+        return ((size_t)chunk * CHUNK_SIZE + used) * sizeof(T);
+    }
+
+    // Frees every node, keeping the chunks for the next search
+    void reset() {
+        chunk = 0;
+        used = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include "node_store.h"
+
+using namespace std;
+
+
+// Removes all nodes (keeps the allocated memory for the next search)
+void NodeStore::clear() {
+    nodes.clear();
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// Adds the start node of a search, returns its index
+int NodeStore::addRoot() {
+    NodeRecord root;
+    root.parent = NO_PARENT;
+    root.move = 0;
+
+    nodes.push_back(root);
+    return nodes.size() - 1;
+}
+
+
+// Adds a node generated from 'parent' by taking 'move', returns its index
+int NodeStore::addNode(int parent, moveDirection move) {
+    NodeRecord node;
+    node.parent = parent;
+    node.move = move;
+
+    nodes.push_back(node);
+    return nodes.size() - 1;
+}
+
+
+// The moveDirection that produced 'node', or -1 for the root
+int NodeStore::getMove(int node) {
+    if(nodes[node].parent == NO_PARENT) {
+        return -1;
+    }
+    return nodes[node].move;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Rebuilds the path (e.g. "DDLURD") that leads from the root to 'node'
+//      by following the parent indexes back to the root, then reversing.
+//
+///////////////////////////////////////////////////////////////////////////////
+string NodeStore::getPath(int node) {
+
+    string path = "";
+
+    while(nodes[node].parent != NO_PARENT) {
+        path += moveLetters[nodes[node].move];
+        node = nodes[node].parent;
+    }
+
+    reverse(path.begin(), path.end());
+    return path;
+}
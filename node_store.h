@@ -0,0 +1,46 @@
+#ifndef __NODE_STORE_H__
+#define __NODE_STORE_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "board.h"
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Store of every node generated by a search. A node only records the index of its parent
+//  and the 2-bit move that produced it (4 bytes), so nodes don't each carry a copy of the
+//  path so far. The path is rebuilt once, by walking back from the goal node to the root.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct NodeRecord {
+    uint32_t parent : 30;   // index of the node this one was generated from
+    uint32_t move : 2;      // moveDirection taken from the parent
+};
+
+
+class NodeStore {
+
+private:
+    vector<NodeRecord> nodes;
+
+public:
+    static const uint32_t NO_PARENT = (1u << 30) - 1;     // parent of the root node
+
+    void clear();
+    int addRoot();
+    int addNode(int parent, moveDirection move);
+
+    string getPath(int node);
+    int getMove(int node);
+
+    int size(){
+        return nodes.size();
+    }
+};
+
+#endif
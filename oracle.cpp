@@ -0,0 +1,122 @@
+#include "oracle.h"
+#include "canonical.h"
+#include "search_clock.h"
+
+using namespace std;
+
+
+const int DistanceTable::UNREACHABLE;
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Breadth first search from the goal, one layer (distance) at a time.
+//      Every move can be undone, so the distance from the goal is the
+//      distance to it.
+//
+///////////////////////////////////////////////////////////////////////////////
+DistanceTable::DistanceTable(PackedState goal) : distance(NUM_PERMUTATIONS, UNREACHABLE) {
+
+    vector<PackedState> layer(1, goal);
+    vector<PackedState> nextLayer;
+    distance[rankState(goal)] = 0;
+
+    for(int d = 1; !layer.empty(); d++) {
+
+        nextLayer.clear();
+
+        for(size_t i = 0; i < layer.size(); i++) {
+            const BlankMoves &moves = blankMoves[blankIndex(layer[i])];
+
+            for(int m = 0; m < moves.count; m++) {
+                PackedState child = slideBlank(layer[i], moves.cell[m]);
+                int rank = rankState(child);
+
+                if(distance[rank] == UNREACHABLE) {
+                    distance[rank] = d;
+                    nextLayer.push_back(child);
+                }
+            }
+        }
+        layer.swap(nextLayer);
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// Table for the goal with its blank in cell 'Blank', built on first use (thread safe in C++11)
+template <int Blank>
+static const DistanceTable &tableFor() {
+    static const DistanceTable table(canonicalGoal(Blank));
+    return table;
+}
+
+static const DistanceTable &(*const distanceTables[NUM_CELLS])() = {
+    tableFor<0>, tableFor<1>, tableFor<2>, tableFor<3>, tableFor<4>, tableFor<5>, tableFor<6>, tableFor<7>, tableFor<8>
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+///////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Search Algorithm:  Oracle (distance table lookup)
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+string oracle(string const initialState, string const goalState, SearchMetrics &metrics) {
+
+    GoalRelabeling relabeling(goalState);
+    const DistanceTable &table = distanceTables[relabeling.getBlank()]();
+
+    SearchTime startTime = searchClock();
+    string path = "";
+
+    PackedState state = relabeling.relabel(packBoard(initialState));
+
+    metrics.numOfStateExpansions = 0;
+    metrics.numOfGeneratedNodes = 0;
+    int d = table.getDistance(state);
+
+    if(d != DistanceTable::UNREACHABLE) {
+
+        // step down the distances
+        while(d > 0) {
+            const BlankMoves &moves = blankMoves[blankIndex(state)];
+            metrics.numOfStateExpansions++;
+
+            for(int m = 0; m < moves.count; m++) {
+                PackedState child = slideBlank(state, moves.cell[m]);
+                metrics.numOfGeneratedNodes++;
+                if(table.getDistance(child) == d - 1) {
+                    path += moveLetters[moves.move[m]];
+                    state = child;
+                    break;
+                }
+            }
+            d--;
+        }
+    }
+
+    metrics.pathLength = path.length();
+    metrics.maxQLength = 0;
+    metrics.numOfDeletionsFromMiddleOfHeap = 0;
+    metrics.numOfLocalLoopsAvoided = 0;
+    metrics.numOfAttemptedNodeReExpansions = 0;
+    metrics.peakMemoryBytes = 0;
+    metrics.actualRunningTime = secondsSince(startTime);
+    return path;
+}
+
+
+string oracle(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                int &numOfAttemptedNodeReExpansions) {
+
+    SearchMetrics metrics;
+    string path = oracle(initialState, goalState, metrics);
+
+    metrics.getCounters(pathLength, numOfStateExpansions, maxQLength, actualRunningTime, numOfDeletionsFromMiddleOfHeap,
+                        numOfLocalLoopsAvoided, numOfAttemptedNodeReExpansions);
+    return path;
+}
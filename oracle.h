@@ -0,0 +1,59 @@
+#ifndef __ORACLE_H__
+#define __ORACLE_H__
+
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "permutation.h"
+#include "search_metrics.h"
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Exact distance to the goal of every board, found by one breadth first search back from
+//  the goal (retrograde BFS) over the 181,440 boards that can reach it. Indexed by the
+//  permutation rank, one byte each (the distances only need 5 bits, the longest is 31).
+//  Boards that can't reach the goal are UNREACHABLE.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class DistanceTable {
+
+private:
+    vector<unsigned char> distance;
+
+public:
+    static const int UNREACHABLE = 0xFF;
+
+    explicit DistanceTable(PackedState goal);
+
+    int getDistance(PackedState state) const {
+        return distance[rankState(state)];
+    }
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Oracle solver. Answers from the distance table with no search: from the start, always
+//  move to a child that is one move closer to the goal, so it takes O(path length) steps.
+//
+//  Tables are built for the standard goal of each blank cell (see canonical.h), and the
+//  start is renamed to match. Each table is built the first time it is needed (about 30ms)
+//  and then shared.
+//
+//  Same counters as the searches: numOfStateExpansions is the boards stepped through, the
+//  'Q', deletion, loop and re-expansion counters stay 0.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+string oracle(string const initialState, string const goalState, int& pathLength, int &numOfStateExpansions, int& maxQLength,
+                float &actualRunningTime, int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided,
+                int &numOfAttemptedNodeReExpansions);
+
+// The same, handing back every metric. numOfGeneratedNodes is the children looked up, and the
+// tables are shared by every search so peakMemoryBytes stays 0.
+string oracle(string const initialState, string const goalState, SearchMetrics &metrics);
+
+#endif
@@ -0,0 +1,218 @@
+#include <deque>
+#include <fstream>
+#include "pattern_database.h"
+
+using namespace std;
+
+
+// first bytes of a pattern database file
+static const char FILE_MAGIC[4] = {'P', 'D', 'B', '1'};
+
+// marks an abstract state the generation has not reached yet
+static const unsigned char UNREACHED = 0xFF;
+
+
+// Number of ways to place 'count' distinct tiles in the 9 cells (9 * 8 * ...)
+static int numPlacements(int count) {
+    int n = 1;
+    for(int i = 0; i < count; i++) {
+        n *= NUM_CELLS - i;
+    }
+    return n;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Ranks 'count' distinct cells as a partial permutation, giving each
+//      placement a unique number in 0 .. numPlacements(count)-1. Same idea
+//      as the Lehmer code in permutation.cpp, stopped after 'count' digits.
+//
+///////////////////////////////////////////////////////////////////////////////
+static int rankCells(const int *cells, int count) {
+
+    int rank = 0;
+
+    for(int i = 0; i < count; i++) {
+        int smaller = 0;
+        for(int j = 0; j < i; j++) {
+            if(cells[j] < cells[i]) {
+                smaller++;
+            }
+        }
+        rank = rank * (NUM_CELLS - i) + (cells[i] - smaller);
+    }
+    return rank;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// Cells of the pattern tiles, then the cell of the blank
+struct AbstractState {
+    int cells[MAX_PATTERN_TILES + 1];
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Generates the database with a breadth first search back from the
+//      goal over the abstract states (cells of the pattern tiles and of the
+//      blank). Moving a pattern tile costs 1 and moving any other tile
+//      costs 0, so it is a 0-1 BFS: free moves go on the front of the
+//      deque, counted moves on the back. Every move can be undone, so the
+//      distance back from the goal is the distance to it.
+//
+///////////////////////////////////////////////////////////////////////////////
+void PatternDatabase::build(PackedState goal, const int *patternTiles, int count) {
+
+    goalState = goal;
+    numTiles = count;
+
+    AbstractState start;
+    for(int i = 0; i < numTiles; i++) {
+        tiles[i] = patternTiles[i];
+        for(int cell = 0; cell < NUM_CELLS; cell++) {
+            if(tileAt(goal, cell) == tiles[i]) {
+                start.cells[i] = cell;
+            }
+        }
+    }
+    start.cells[numTiles] = blankIndex(goal);
+
+    costs.assign(numPlacements(numTiles + 1), UNREACHED);
+    vector<bool> done(costs.size(), false);
+
+    deque<AbstractState> open;
+    costs[rankCells(start.cells, numTiles + 1)] = 0;
+    open.push_back(start);
+
+    while(!open.empty()) {
+
+        AbstractState current = open.front();
+        open.pop_front();
+
+        int rank = rankCells(current.cells, numTiles + 1);
+        if(done[rank]) {
+            continue;
+        }
+        done[rank] = true;
+
+        int cost = costs[rank];
+        int blank = current.cells[numTiles];
+        const BlankMoves &moves = blankMoves[blank];
+
+        for(int i = 0; i < moves.count; i++) {
+
+            AbstractState next = current;
+            next.cells[numTiles] = moves.cell[i];
+
+            // the blank swaps with a pattern tile (costs 1) or with any other tile (free)
+            int stepCost = 0;
+            for(int t = 0; t < numTiles; t++) {
+                if(current.cells[t] == moves.cell[i]) {
+                    next.cells[t] = blank;
+                    stepCost = 1;
+                }
+            }
+
+            int nextRank = rankCells(next.cells, numTiles + 1);
+            if(cost + stepCost < costs[nextRank]) {
+                costs[nextRank] = cost + stepCost;
+                if(stepCost == 0) {
+                    open.push_front(next);
+                }
+                else {
+                    open.push_back(next);
+                }
+            }
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      File format (binary):
+//          4 bytes     "PDB1"
+//          9 bytes     goal board, as in "123456780"
+//          1 byte      number of tiles in the pattern
+//          n bytes     the pattern tiles
+//          rest        one byte per entry, in rankCells() order
+//
+///////////////////////////////////////////////////////////////////////////////
+bool PatternDatabase::save(string const fileName) const {
+
+    ofstream file(fileName.c_str(), ios::binary);
+    if(!file) {
+        return false;
+    }
+
+    string goal = unpackBoard(goalState);
+    file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    file.write(goal.data(), NUM_CELLS);
+    file.put((char)numTiles);
+    for(int i = 0; i < numTiles; i++) {
+        file.put((char)tiles[i]);
+    }
+    file.write((const char *)costs.data(), costs.size());
+
+    return (bool)file;
+}
+
+
+// Reads a database saved by save(). Fails if the file is missing, short, or was built for another goal or pattern
+bool PatternDatabase::load(string const fileName, PackedState goal, const int *patternTiles, int count) {
+
+    ifstream file(fileName.c_str(), ios::binary);
+    if(!file) {
+        return false;
+    }
+
+    char magic[sizeof(FILE_MAGIC)];
+    char goalText[NUM_CELLS];
+    file.read(magic, sizeof(magic));
+    file.read(goalText, NUM_CELLS);
+
+    if(!file || string(magic, sizeof(magic)) != string(FILE_MAGIC, sizeof(FILE_MAGIC))
+       || string(goalText, NUM_CELLS) != unpackBoard(goal)) {
+        return false;
+    }
+    if(file.get() != count) {
+        return false;
+    }
+    for(int i = 0; i < count; i++) {
+        if(file.get() != patternTiles[i]) {
+            return false;
+        }
+    }
+
+    vector<unsigned char> entries(numPlacements(count + 1));
+    file.read((char *)entries.data(), entries.size());
+    if(!file) {
+        return false;
+    }
+
+    goalState = goal;
+    numTiles = count;
+    for(int i = 0; i < count; i++) {
+        tiles[i] = patternTiles[i];
+    }
+    costs.swap(entries);
+    return true;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+int PatternDatabase::getCost(const int *cellOf) const {
+
+    int cells[MAX_PATTERN_TILES + 1];
+    for(int i = 0; i < numTiles; i++) {
+        cells[i] = cellOf[tiles[i]];
+    }
+    cells[numTiles] = cellOf[0];
+    return costs[rankCells(cells, numTiles + 1)];
+}
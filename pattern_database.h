@@ -0,0 +1,52 @@
+#ifndef __PATTERN_DATABASE_H__
+#define __PATTERN_DATABASE_H__
+
+#include <string>
+#include <vector>
+
+#include "board.h"
+
+using namespace std;
+
+
+const int MAX_PATTERN_TILES = 4;       // tiles in one pattern, with the blank the table has 9*8*7*6*5 = 15120 entries
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Pattern database for one group of tiles. Holds, for every placement of the tiles in the
+//  pattern and the blank, the fewest moves OF THOSE TILES needed to bring them to their goal
+//  cells (moves of the other tiles are free). As only moves of its own tiles are counted,
+//  the values of databases with no tile in common can be added together and the sum is
+//  still an admissible heuristic.
+//
+//  The blank is kept in the entry (rather than taking the lowest cost over every blank
+//  cell) because the pattern tiles can wall the blank in. Without it a move could drop the
+//  value by more than 1, and A* with a strict expanded list needs it to change by at most 1.
+//
+//  Entries are indexed by the rank of the cells of the pattern tiles and the blank as a
+//  partial permutation, so there are no unused entries, and the file on disk is a short
+//  header plus one byte per entry in that same order.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class PatternDatabase {
+
+private:
+    PackedState goalState;                  // GOAL board the database was built for
+    int numTiles;
+    int tiles[MAX_PATTERN_TILES];           // tiles in the pattern
+    vector<unsigned char> costs;            // moves of the pattern tiles, by rankCells() of their cells and the blank's
+
+public:
+    PatternDatabase() : goalState(0), numTiles(0) {}
+
+    void build(PackedState goal, const int *patternTiles, int count);
+
+    bool save(string const fileName) const;
+    bool load(string const fileName, PackedState goal, const int *patternTiles, int count);
+
+    // Cost for the pattern tiles and blank being in the cells given by 'cellOf' (cell of each tile, indexed by tile)
+    int getCost(const int *cellOf) const;
+};
+
+#endif
@@ -0,0 +1,72 @@
+#include "permutation.h"
+
+using namespace std;
+
+
+// factorials 0! - 8!, weight of each Lehmer digit
+static const int factorial[NUM_CELLS] = { 1, 1, 2, 6, 24, 120, 720, 5040, 40320 };
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+//
+//      Ranks a board. The Lehmer digit for cell 'n' is the number of tiles after it that
+//      are smaller, which is the tile number minus how many smaller tiles have already
+//      been seen. 'seen' is a bitmask of the tiles already looked at.
+//
+///////////////////////////////////////////////////////////////////////////////////////////
+int rankState(PackedState state) {
+
+    int rank = 0;
+    unsigned int seen = 0;
+
+    for(int n = 0; n < NUM_CELLS; n++) {
+        int tile = tileAt(state, n);
+        int digit = tile - __builtin_popcount(seen & ((1u << tile) - 1));
+
+        rank += digit * factorial[NUM_CELLS - 1 - n];
+        seen |= 1u << tile;
+    }
+
+    return rank;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+///////////////////////////////////////////////////////////////////////////////////////////
+//
+//      Inverse of rankState(). Each Lehmer digit picks the digit'th smallest tile that
+//      has not been placed yet.
+//
+///////////////////////////////////////////////////////////////////////////////////////////
+PackedState unrankState(int rank) {
+
+    PackedState state = 0;
+    unsigned int used = 0;
+
+    for(int n = 0; n < NUM_CELLS; n++) {
+        int digit = rank / factorial[NUM_CELLS - 1 - n];
+        rank %= factorial[NUM_CELLS - 1 - n];
+
+        // find the digit'th unused tile
+        int tile = 0;
+        while(true) {
+            if(!(used & (1u << tile))) {
+                if(digit == 0) {
+                    break;
+                }
+                digit--;
+            }
+            tile++;
+        }
+
+        used |= 1u << tile;
+        state |= (PackedState)tile << (4 * n);
+
+        if(tile == 0) {
+            state |= (PackedState)n << BLANK_SHIFT;
+        }
+    }
+
+    return state;
+}
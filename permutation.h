@@ -0,0 +1,21 @@
+#ifndef __PERMUTATION_H__
+#define __PERMUTATION_H__
+
+#include "board.h"
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Perfect hash of a board onto 0 .. 9!-1 using its Lehmer code (factorial number system).
+//  Every arrangement of the 9 tiles gets a unique rank, so a rank can be used directly as
+//  an array/bit index instead of hashing the state.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+const int NUM_PERMUTATIONS = 362880;    // 9!
+
+
+int rankState(PackedState state);
+PackedState unrankState(int rank);
+
+#endif
@@ -1,33 +1,37 @@
+#ifndef __PUZZLE_H__
+#define __PUZZLE_H__
+
 #include <string>
 #include <iostream>
 
-using namespace std;
-
+#include "board.h"
+#include "node_arena.h"
+#include "goal_context.h"
+#include "heuristic.h"
 
-enum heuristicFunction{misplacedTiles, manhattanDistance};
+using namespace std;
 
 
 class Puzzle{
         
 private:
-    string path;            // current path taken
+    int node;               // index of this state's record in the search's NodeStore, used to rebuild the path taken
     int pathLength;         // length of the path taken so far, also used as gCost as every move cost = 1.
     int hCost;              // used by A*
     int fCost;              // used by A*
+    heuristicFunction hFunction;    // heuristic hCost was computed with, children update it incrementally
+    HeuristicCode hCode;            // what the heuristic keeps about 'state' besides hCost (see heuristic.h)
         
-    int goalBoard[3][3];    // GOAL board configuration
-    int x0, y0;             //coordinates of the blank/0 tile
-    int board[3][3];        // CURRENT board config
+    const GoalContext *goal;    // GOAL board configuration and tables, shared by every Puzzle of a search
+    PackedState state;      // CURRENT board config, packed 4 bits per cell (also holds the blank/0 tile position)
 
+    void slideBlankTo(int cell);
 
-public:
-    
-    static pair<int, int> goalStateCoords[8];  
 
-    string strBoard;
+public:
      
     Puzzle(const Puzzle &p);    //Constructor
-    Puzzle(string const elements, string const goal);
+    Puzzle(string const elements, const GoalContext &goal);
      
     void printBoard();
     
@@ -39,7 +43,11 @@ public:
     string toString();
     
     string getString(){
-        return strBoard;
+        return toString();
+    }
+
+    PackedState getState(){
+        return state;
     }
     
     // Check if an action can be taken
@@ -49,15 +57,19 @@ public:
     bool canMoveDown();  
     
     // Performs the action and updates the state of the puzzle
+    Puzzle * moveBlank(int cell, NodeArena<Puzzle> &arena);
     Puzzle * moveUp();
     Puzzle * moveRight();
     Puzzle * moveDown();
     Puzzle * moveLeft();
     
-    const string getPath();
+    int getNode();
+    void setNode(int nodeIndex);
 
     int getPathLength();
     int getFCost();
     int getHCost();
     int getGCost();    
 };
+
+#endif
@@ -0,0 +1,198 @@
+#include <utility>
+#include "search_api.h"
+#include "ida_star.h"
+#include "hda_star.h"
+#include "oracle.h"
+
+using namespace std;
+
+
+// Heuristic named at the end of an algorithm name, e.g. "manhattan" in "astar_explist_manhattan"
+static bool heuristicNamed(string const &name, heuristicFunction &heuristic) {
+
+    if(name == "misplacedtiles") heuristic = misplacedTiles;
+    else if(name == "manhattan") heuristic = manhattanDistance;
+    else if(name == "pdb") heuristic = patternDatabase;
+    else if(name == "linearconflict") heuristic = linearConflict;
+    else if(name == "walkingdistance") heuristic = walkingDistance;
+    else return false;
+
+    return true;
+}
+
+
+// True if 'name' starts with 'prefix', and the rest of it names a heuristic
+static bool heuristicAfter(string const &name, string const &prefix, heuristicFunction &heuristic) {
+    return name.compare(0, prefix.length(), prefix) == 0 && heuristicNamed(name.substr(prefix.length()), heuristic);
+}
+
+
+bool requestNamed(string const &name, SearchRequest &request) {
+
+    // "_bucket" on the end of a Uniform Cost or A* name runs it with buckets for 'Q' instead of the heap
+    static const string bucketSuffix = "_bucket";
+
+    if(name.length() > bucketSuffix.length()
+       && name.compare(name.length() - bucketSuffix.length(), bucketSuffix.length(), bucketSuffix) == 0) {
+
+        SearchRequest bucketed = request;
+        if(!requestNamed(name.substr(0, name.length() - bucketSuffix.length()), bucketed)
+           || (bucketed.algorithm != uniformCostSearch && bucketed.algorithm != aStarSearch)) {
+            return false;
+        }
+        bucketed.frontier = bucketFrontier;
+        request = bucketed;
+        return true;
+    }
+
+    heuristicFunction heuristic = request.heuristic;
+
+    if(name == "uc_explist") {
+        request.algorithm = uniformCostSearch;
+    }
+    else if(name == "uc_bidirectional") {
+        request.algorithm = bidirectionalSearch;
+    }
+    else if(heuristicAfter(name, "astar_explist_", heuristic)) {
+        request.algorithm = aStarSearch;
+    }
+    else if(heuristicAfter(name, "idastar_", heuristic)) {
+        request.algorithm = idaStarSearch;
+    }
+    else if(heuristicAfter(name, "pidastar_", heuristic)) {
+        request.algorithm = parallelIdaStarSearch;
+    }
+    else if(heuristicAfter(name, "hdastar_", heuristic)) {
+        request.algorithm = hdaStarSearch;
+    }
+    else if(name == "wastar_manhattan") {
+        request.algorithm = weightedAStarSearch;
+        request.weight = 2.0;
+    }
+    else if(name == "arastar_manhattan") {
+        request.algorithm = anytimeAStarSearch;
+        request.weight = 3.0;
+        request.timeBudget = 1.0;
+        request.expansionBudget = 0;
+    }
+    else if(name == "oracle") {
+        request.algorithm = oracleSearch;
+    }
+    else {
+        return false;
+    }
+
+    request.heuristic = heuristic;
+    request.frontier = heapFrontier;
+    return true;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// Runs a search that keeps its state in 'context', and takes its results from there
+static void runInContext(SearchRequest const &request, SearchContext &context, SearchResult &result) {
+
+    string const &initialState = request.initialState;
+    string const &goalState = request.goalState;
+    heuristicFunction heuristic = request.heuristic;
+
+    switch(request.algorithm) {
+        case uniformCostSearch:
+            result.path = context.uniformCost(initialState, goalState, request.frontier);
+            break;
+        case aStarSearch:
+            result.path = context.aStar(initialState, goalState, heuristic, request.frontier);
+            break;
+        case bidirectionalSearch:
+            result.path = context.bidirectionalUniformCost(initialState, goalState);
+            break;
+        case weightedAStarSearch:
+            result.path = context.weightedAStar(initialState, goalState, heuristic, request.weight);
+            break;
+        case anytimeAStarSearch:
+            result.path = context.anytimeAStar(initialState, goalState, heuristic, request.weight, request.timeBudget,
+                                               request.expansionBudget, request.report);
+            break;
+
+        // solve() runs these itself, they keep nothing in a context
+        case idaStarSearch:
+        case parallelIdaStarSearch:
+        case hdaStarSearch:
+        case oracleSearch:
+            return;
+    }
+
+    result.status = context.status;
+    context.getMetrics(result.metrics);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Every search returns its path by value, and it is move assigned
+//      into the result, so the moves are never copied on the way out.
+//
+///////////////////////////////////////////////////////////////////////////////
+SearchResult solve(SearchRequest const &request, SearchContext &context) {
+
+    SearchTime startTime = searchClock();
+    SearchResult result;
+    result.status = noSolutionFound;
+
+    string const &initialState = request.initialState;
+    string const &goalState = request.goalState;
+
+    if(!isBoard(initialState) || !isBoard(goalState)) {
+        result.status = invalidBoard;
+    }
+
+    // the searches turn these away too, but the ones that keep no context would not say why
+    else if(!isSolvable(packBoard(initialState), packBoard(goalState))) {
+        result.status = unsolvable;
+    }
+
+    // the searches without a context are complete, so a solvable pair always has a path (of length 0 if start is goal)
+    else {
+        switch(request.algorithm) {
+            case idaStarSearch:
+                result.path = idaStar(initialState, goalState, request.heuristic, result.metrics);
+                result.status = solutionFound;
+                break;
+            case parallelIdaStarSearch:
+                result.path = parallelIdaStar(initialState, goalState, request.heuristic, request.numThreads, result.metrics);
+                result.status = solutionFound;
+                break;
+            case hdaStarSearch:
+                result.path = hdaStar(initialState, goalState, request.heuristic, request.numThreads, result.metrics);
+                result.status = solutionFound;
+                break;
+            case oracleSearch:
+                result.path = oracle(initialState, goalState, result.metrics);
+                result.status = solutionFound;
+                break;
+            case uniformCostSearch:
+            case aStarSearch:
+            case bidirectionalSearch:
+            case weightedAStarSearch:
+            case anytimeAStarSearch:
+                runInContext(request, context, result);
+                break;
+        }
+    }
+
+    result.metrics.totalTime = secondsSince(startTime);
+    result.metrics.setupTime = result.metrics.totalTime - result.metrics.actualRunningTime;
+    if(result.metrics.setupTime < 0) {
+        result.metrics.setupTime = 0;
+    }
+    return result;
+}
+
+
+// Each thread gets its own context the first time it calls solve() without one, and keeps it
+SearchResult solve(SearchRequest const &request) {
+
+    static thread_local SearchContext context;
+    return solve(request, context);
+}
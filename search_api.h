@@ -0,0 +1,68 @@
+#ifndef __SEARCH_API_H__
+#define __SEARCH_API_H__
+
+#include <string>
+
+#include "heuristic.h"
+#include "search_context.h"
+#include "search_metrics.h"
+
+using namespace std;
+
+
+// Every search the solver can run
+enum searchAlgorithm{uniformCostSearch, aStarSearch, bidirectionalSearch, weightedAStarSearch, anytimeAStarSearch, idaStarSearch,
+                     parallelIdaStarSearch, hdaStarSearch, oracleSearch};
+
+
+// What to solve and how. Options an algorithm doesn't use are ignored.
+struct SearchRequest {
+    string initialState;
+    string goalState;
+    searchAlgorithm algorithm;
+    heuristicFunction heuristic;        // not used by the uniform cost searches or the oracle
+    frontierType frontier;              // uniform cost and A*
+    float weight;                       // weighted A*, and the first weight of ARA*
+    float timeBudget;                   // ARA*, in seconds (0 = no limit)
+    int expansionBudget;                // ARA* (0 = no limit)
+    int numThreads;                     // HDA* and parallel IDA* (0 = one per core)
+    anytimeReport report;               // ARA*, called with each better path (or NULL)
+
+    SearchRequest(string const &initialState = "", string const &goalState = "", searchAlgorithm algorithm = aStarSearch,
+                  heuristicFunction heuristic = manhattanDistance)
+        : initialState(initialState), goalState(goalState), algorithm(algorithm), heuristic(heuristic), frontier(heapFrontier),
+          weight(2.0), timeBudget(1.0), expansionBudget(0), numThreads(0), report(NULL) {}
+};
+
+
+// What a search found. 'path' is the moves of the blank, e.g. "DDLURD".
+struct SearchResult {
+    searchStatus status;
+    string path;
+    SearchMetrics metrics;
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  solve() - the one entry point for every search. Checks both boards, turns away an
+//            unsolvable pair without searching, then runs the requested algorithm. The
+//            path is moved into the result, never copied.
+//
+//            Runs in 'context', or in one kept for each thread if none is given, so any
+//            number of threads can call it at once.
+//
+//  requestNamed() - sets the algorithm and heuristic of 'request' from a name as given
+//                   on the command line (e.g. "astar_explist_manhattan"), with the weights
+//                   a single_run uses for weighted A* (2) and ARA* (3, for 1 second).
+//                   "_bucket" on the end of a Uniform Cost or A* name selects the bucket
+//                   queue for 'Q', e.g. "astar_explist_manhattan_bucket".
+//                   Returns false, leaving 'request' as it was, if the name is not recognised.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+SearchResult solve(SearchRequest const &request, SearchContext &context);
+SearchResult solve(SearchRequest const &request);
+
+bool requestNamed(string const &name, SearchRequest &request);
+
+#endif
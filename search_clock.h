@@ -0,0 +1,26 @@
+#ifndef __SEARCH_CLOCK_H__
+#define __SEARCH_CLOCK_H__
+
+#include <chrono>
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Wall clock timing of a search. clock() counts the CPU time of the whole process, so with
+//  searches running on several threads at once it would add up the time of all of them.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+typedef chrono::steady_clock::time_point SearchTime;
+
+inline SearchTime searchClock() {
+    return chrono::steady_clock::now();
+}
+
+// Seconds since 'start'
+inline float secondsSince(SearchTime start) {
+    return chrono::duration<float>(chrono::steady_clock::now() - start).count();
+}
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef __SEARCH_CONTEXT_H__
+#define __SEARCH_CONTEXT_H__
+
+#include <memory>
+#include <string>
+
+#include "puzzle.h"
+#include "solvability.h"        // for turning away unsolvable pairs before searching
+#include "closed_list.h"        // for the expanded list
+#include "node_store.h"         // for rebuilding the path
+#include "node_arena.h"         // for allocating the Puzzle objects of a search
+#include "indexed_heap.h"       // for 'Q' as a min-heap
+#include "bucket_queue.h"       // for 'Q' as buckets of equal cost
+#include "bidirectional.h"      // for the two sides of a bidirectional search
+#include "anytime_astar.h"      // for weighted A* and ARA*
+#include "search_clock.h"       // for timing the searches
+#include "search_metrics.h"     // for handing back the results of a search
+
+using namespace std;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Custom comparators.
+//  Used "https://www.geeksforgeeks.org/comparator-in-cpp/" for how to do comparator
+//
+//      - Uniform Cost will compare using the g-cost
+//      - A* will compare using the f-cost (= gcost + hcost)
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// Custom comparator for the Uniform Cost 'Q' to maintain a min-heap. Uses gCost
+struct gCostComparator {
+    bool operator() (Puzzle *p1, Puzzle *p2) const {
+        return p1->getGCost() > p2->getGCost();
+    }
+};
+
+// Custom comparator for the A* 'Q' to maintain a min-heap. uses fCost.
+struct fCostComparator {
+    bool operator() (Puzzle *p1, Puzzle *p2) const {
+        return p1->getFCost() > p2->getFCost();
+    }
+};
+
+// Cost used to pick the bucket in a BucketQueue 'Q'. Uniform Cost uses the gCost
+struct gCostKey {
+    int operator() (Puzzle *p) const {
+        return p->getGCost();
+    }
+};
+
+// Cost used to pick the bucket in a BucketQueue 'Q'. A* uses the fCost
+struct fCostKey {
+    int operator() (Puzzle *p) const {
+        return p->getFCost();
+    }
+};
+
+
+// The 'Q' types each algorithm can use. A min-heap, or buckets indexed by cost, both able to look up
+// and lower the cost of a state already in 'Q'. The searches are templates so either can be used.
+typedef IndexedHeap<Puzzle *, gCostComparator> UniformCostHeapQ;
+typedef IndexedHeap<Puzzle *, fCostComparator> AStarHeapQ;
+typedef BucketQueue<Puzzle *, gCostKey> UniformCostBucketQ;
+typedef BucketQueue<Puzzle *, fCostKey> AStarBucketQ;
+
+// Which priority queue the searches use for 'Q'. A binary heap, or buckets indexed by the (small, integer) cost.
+enum frontierType{heapFrontier, bucketFrontier};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Everything one search needs: expanded list, 'Q', node store, node arena and counters.
+//  Nothing is shared between contexts, so searches in different contexts can run at the
+//  same time. A context can be reused for any number of searches one after the other, and
+//  keeps its allocated memory (hash/bit tables, vectors, arena chunks) between them.
+//
+//  The counters hold the results of the last search run in the context.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class SearchContext {
+
+private:
+    ClosedList expandedList;            // expanded list, bitset indexed by the permutation rank of each state
+    NodeStore nodeStore;                // parent and move of every node put into 'Q'
+    NodeArena<Puzzle> nodeArena;        // owns every Puzzle object of the search, 'Q' only holds pointers
+
+    // the 'Q' of each type, only created the first time a search uses it
+    unique_ptr<UniformCostHeapQ> ucHeapQ;
+    unique_ptr<UniformCostBucketQ> ucBucketQ;
+    unique_ptr<AStarHeapQ> aStarHeapQ;
+    unique_ptr<AStarBucketQ> aStarBucketQ;
+
+    // the two sides of a bidirectional search, only created the first time one is run
+    unique_ptr<SearchDirection> forwardSide;
+    unique_ptr<SearchDirection> backwardSide;
+
+    // weighted A* / ARA* tables, only created the first time one is run
+    unique_ptr<AnytimeSearch> anytime;
+
+    void reset();
+    bool rejectUnsolvable(string const &initialState, string const &goalState);
+    size_t nodeMemory();
+
+    template <typename QType>
+    void clearQ(unique_ptr<QType> &Q) {
+        if(Q) {
+            Q->clear();
+        }
+    }
+
+    // reset() has already emptied the 'Q', this only creates it the first time
+    template <typename QType>
+    QType &emptyQ(unique_ptr<QType> &Q) {
+        if(!Q) {
+            Q.reset(new QType());
+        }
+        return *Q;
+    }
+
+    template <typename QType>
+    void updateUniformCostQ(Puzzle *updatedState, int parentNode, moveDirection move, QType &Q);
+    template <typename QType>
+    void updateAStarQ(Puzzle *updatedState, int parentNode, moveDirection move, QType &Q);
+
+    template <typename QType>
+    string ucSearch(QType &Q, string const initialState, string const goalState);
+    template <typename QType>
+    string aStarSearch(QType &Q, string const initialState, string const goalState, heuristicFunction heuristic);
+
+    void expandLayer(SearchDirection &side, SearchDirection &other, int &bestCost, int &sideMeet, int &otherMeet);
+
+    string anytimeSearch(string const initialState, string const goalState, heuristicFunction heuristic, float initialWeight,
+                         float weightStep, float timeBudget, int expansionBudget, anytimeReport report);
+
+public:
+    // results of the last search
+    int pathLength;
+    int numOfStateExpansions;
+    int maxQLength;
+    float actualRunningTime;
+    int numOfDeletionsFromMiddleOfHeap;
+    int numOfLocalLoopsAvoided;
+    int numOfAttemptedNodeReExpansions;
+    searchStatus status;
+    float suboptimalityBound;           // path is at most this times the optimal length (1 for the exact searches)
+    int numOfGeneratedNodes;
+    size_t peakMemoryBytes;             // see search_metrics.h for what is counted
+
+    SearchContext();
+
+    string uniformCost(string const initialState, string const goalState, frontierType frontier = heapFrontier);
+    string aStar(string const initialState, string const goalState, heuristicFunction heuristic, frontierType frontier = heapFrontier);
+    string bidirectionalUniformCost(string const initialState, string const goalState);
+    string weightedAStar(string const initialState, string const goalState, heuristicFunction heuristic, float weight);
+    string anytimeAStar(string const initialState, string const goalState, heuristicFunction heuristic, float initialWeight,
+                        float timeBudget, int expansionBudget, anytimeReport report = NULL);
+
+    // copies the counters of the last search into the out-parameters of the original interface (see SearchMetrics::getCounters)
+    void getCounters(int& pathLength, int &numOfStateExpansions, int& maxQLength, float &actualRunningTime,
+                     int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided, int &numOfAttemptedNodeReExpansions);
+
+    // copies every result of the last search into 'metrics' (apart from the times outside the search)
+    void getMetrics(SearchMetrics &metrics);
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef __SEARCH_METRICS_H__
+#define __SEARCH_METRICS_H__
+
+#include <cstddef>
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Everything measured about one search. The first seven are the counters of the original
+//  interface (the out-parameters of uc_explist() etc.), the rest are only filled in by the
+//  searches that take a SearchMetrics.
+//
+//      numOfLocalLoopsAvoided - children not made because they would undo the move that
+//                            reached the board (Uniform Cost, A* and IDA*). Uniform Cost
+//                            and A* would find them expanded already, so they are not
+//                            counted as attempted re-expansions either.
+//      numOfGeneratedNodes - children made from the expanded boards, not counting those.
+//      peakMemoryBytes     - memory for the nodes of the search at its largest: the node
+//                            objects, their path records and the 'Q' entries. Tables
+//                            indexed by rank are the same size for every search, and are
+//                            not counted.
+//      setupTime           - time spent outside the search itself: the checks, renaming
+//                            the tiles, goal tables built on first use, starting threads
+//      totalTime           - the whole call, setupTime + actualRunningTime
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct SearchMetrics {
+    int pathLength;
+    int numOfStateExpansions;
+    int maxQLength;
+    float actualRunningTime;            // the search itself, in seconds
+    int numOfDeletionsFromMiddleOfHeap;
+    int numOfLocalLoopsAvoided;
+    int numOfAttemptedNodeReExpansions;
+
+    int numOfGeneratedNodes;
+    size_t peakMemoryBytes;
+    float setupTime;
+    float totalTime;
+    float suboptimalityBound;           // path is at most this times the optimal length (1 for the exact searches)
+
+    SearchMetrics()
+        : pathLength(0), numOfStateExpansions(0), maxQLength(0), actualRunningTime(0.0), numOfDeletionsFromMiddleOfHeap(0),
+          numOfLocalLoopsAvoided(0), numOfAttemptedNodeReExpansions(0), numOfGeneratedNodes(0), peakMemoryBytes(0),
+          setupTime(0.0), totalTime(0.0), suboptimalityBound(1.0) {}
+
+    // copies the counters into the out-parameters of the original interface
+    void getCounters(int& pathLength, int &numOfStateExpansions, int& maxQLength, float &actualRunningTime,
+                     int &numOfDeletionsFromMiddleOfHeap, int &numOfLocalLoopsAvoided, int &numOfAttemptedNodeReExpansions) const {
+        pathLength = this->pathLength;
+        numOfStateExpansions = this->numOfStateExpansions;
+        maxQLength = this->maxQLength;
+        actualRunningTime = this->actualRunningTime;
+        numOfDeletionsFromMiddleOfHeap = this->numOfDeletionsFromMiddleOfHeap;
+        numOfLocalLoopsAvoided = this->numOfLocalLoopsAvoided;
+        numOfAttemptedNodeReExpansions = this->numOfAttemptedNodeReExpansions;
+    }
+};
+
+#endif
@@ -0,0 +1,31 @@
+#include "solvability.h"
+
+using namespace std;
+
+
+// Inversion parity of a board, plus the blank's row on an even width board (see solvability.h)
+static int boardParity(PackedState state) {
+
+    int inversions = 0;
+    unsigned int seen = 0;
+
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        int tile = tileAt(state, cell);
+        if(tile == 0) {
+            continue;
+        }
+        // tiles already seen that are bigger than this one
+        inversions += __builtin_popcount(seen & ~((1u << tile) - 1));
+        seen |= 1u << tile;
+    }
+
+    if(BOARD_DIM % 2 == 0) {
+        inversions += blankIndex(state) / BOARD_DIM;
+    }
+    return inversions % 2;
+}
+
+
+bool isSolvable(PackedState start, PackedState goal) {
+    return boardParity(start) == boardParity(goal);
+}
@@ -0,0 +1,31 @@
+#ifndef __SOLVABILITY_H__
+#define __SOLVABILITY_H__
+
+#include "board.h"
+
+
+// How a search ended. invalidBoard is only returned by solve(), the searches expect valid boards.
+enum searchStatus{solutionFound, noSolutionFound, unsolvable, invalidBoard};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Whether 'goal' can be reached from 'start' at all, from the permutation parity, so an
+//  unsolvable pair can be turned away before searching the whole reachable half of the
+//  boards (181,440 for 3x3).
+//
+//  Every search checks this before it starts, and returns no path at once if it fails.
+//  Otherwise an unsolvable pair would only stop after every reachable board was expanded
+//  (or, for IDA*, once the bound passed the longest solution).
+//
+//  Every move swaps the blank with one tile. On an odd width board a move up or down
+//  passes the tile over an even number of others, so the number of inversions (pairs of
+//  tiles, not the blank, in the wrong order) keeps its parity. On an even width board it
+//  passes an odd number, so the inversion parity flips every time the blank changes row,
+//  and inversions + blank row keeps its parity instead. Start and goal are reachable from
+//  each other exactly when these parities match.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+bool isSolvable(PackedState start, PackedState goal);
+
+#endif
@@ -0,0 +1,145 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "search_api.h"
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Headless check of the solver ("make check"), linked against libsolver.a only.
+//  Solves a fixed set of boards with every algorithm name a command line accepts, and
+//  compares each path with the oracle's: it must be a legal path from the start to the
+//  goal, as short as the oracle's for the exact searches, and within the proved bound
+//  of it for weighted A* and ARA*. Unsolvable and malformed boards must be turned away.
+//
+//  Prints every failure, and exits with 1 if there was one.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// the batch_run boards, and a few goals with the blank in other cells so the renamed goals are covered
+static const char *initialStates[] = { "120483765", "208135467", "704851632", "536407182", "638541720", "123456780" };
+static const char *goalStates[] = { "123456780", "087654321", "123405678", "802741563" };
+
+static const char *heuristicNames[] = { "misplacedtiles", "manhattan", "pdb", "linearconflict", "walkingdistance" };
+
+
+// Every name requestNamed() accepts
+static vector<string> algorithmNames() {
+
+    vector<string> names;
+    names.push_back("uc_explist");
+    names.push_back("uc_explist_bucket");
+    names.push_back("uc_bidirectional");
+
+    for(size_t i = 0; i < sizeof(heuristicNames) / sizeof(heuristicNames[0]); i++) {
+        string heuristic = heuristicNames[i];
+        names.push_back("astar_explist_" + heuristic);
+        names.push_back("astar_explist_" + heuristic + "_bucket");
+        names.push_back("idastar_" + heuristic);
+        names.push_back("pidastar_" + heuristic);
+        names.push_back("hdastar_" + heuristic);
+    }
+
+    names.push_back("wastar_manhattan");
+    names.push_back("arastar_manhattan");
+    names.push_back("oracle");
+    return names;
+}
+
+
+// True if the moves of 'path' are all legal and take 'initialState' to 'goalState'
+static bool reachesGoal(string const &initialState, string const &goalState, string const &path) {
+
+    PackedState state = packBoard(initialState);
+
+    for(size_t i = 0; i < path.length(); i++) {
+        const BlankMoves &moves = blankMoves[blankIndex(state)];
+        int m = 0;
+        while(m < moves.count && moveLetters[moves.move[m]] != path[i]) {
+            m++;
+        }
+        if(m == moves.count) {
+            return false;
+        }
+        state = slideBlank(state, moves.cell[m]);
+    }
+    return state == packBoard(goalState);
+}
+
+
+// Runs 'name' on one pair, and prints what was wrong if it doesn't agree with the oracle's result 'expected'
+static bool check(string const &name, string const &initialState, string const &goalState, SearchResult const &expected) {
+
+    SearchRequest request(initialState, goalState);
+    requestNamed(name, request);
+    request.numThreads = 2;
+    request.timeBudget = 0;                 // ARA* runs on to the optimal path, so the result doesn't depend on the machine
+
+    SearchResult result = solve(request);
+    string problem;
+
+    if(result.status != expected.status) {
+        problem = "status " + to_string(result.status) + ", expected " + to_string(expected.status);
+    }
+    else if(result.status != solutionFound) {
+        return true;
+    }
+    else if(!reachesGoal(initialState, goalState, result.path)) {
+        problem = "path \"" + result.path + "\" does not reach the goal";
+    }
+    else if(request.algorithm == weightedAStarSearch || request.algorithm == anytimeAStarSearch) {
+        if(result.path.length() < expected.path.length()
+           || result.path.length() > result.metrics.suboptimalityBound * expected.path.length() + 1e-3) {
+            problem = "path length " + to_string(result.path.length()) + " is not within " + to_string(result.metrics.suboptimalityBound)
+                      + " x the oracle's " + to_string(expected.path.length());
+        }
+    }
+    else if(result.path.length() != expected.path.length()) {
+        problem = "path length " + to_string(result.path.length()) + ", the oracle's is " + to_string(expected.path.length());
+    }
+
+    if(problem.empty()) {
+        return true;
+    }
+    cout << "FAILED " << name << " " << initialState << " -> " << goalState << ": " << problem << endl;
+    return false;
+}
+
+
+int main() {
+
+    vector<string> names = algorithmNames();
+    int numOfChecks = 0;
+    int numOfFailures = 0;
+
+    for(size_t g = 0; g < sizeof(goalStates) / sizeof(goalStates[0]); g++) {
+        for(size_t i = 0; i < sizeof(initialStates) / sizeof(initialStates[0]); i++) {
+
+            // the oracle's distance is exact, and it turns the unsolvable pairs away like every search
+            SearchResult expected = solve(SearchRequest(initialStates[i], goalStates[g], oracleSearch));
+
+            for(size_t n = 0; n < names.size(); n++) {
+                numOfChecks++;
+                if(!check(names[n], initialStates[i], goalStates[g], expected)) {
+                    numOfFailures++;
+                }
+            }
+        }
+    }
+
+    // a board with a tile twice is never searched
+    SearchResult invalid;
+    invalid.status = invalidBoard;
+    for(size_t n = 0; n < names.size(); n++) {
+        numOfChecks++;
+        if(!check(names[n], "120483755", goalStates[0], invalid)) {
+            numOfFailures++;
+        }
+    }
+
+    cout << "solver check: " << numOfChecks << " searches, " << numOfFailures << " failed" << endl;
+    return (numOfFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+#include <queue>
+#include "walking_distance.h"
+
+using namespace std;
+
+
+// marks a code the generation has not reached yet
+static const unsigned char UNREACHED = 0xFF;
+
+
+// Count of tiles in 'line' that belong in 'goalLine'
+static int countIn(int code, int line, int goalLine) {
+    return (code >> (2 * (BOARD_DIM * line + goalLine))) & 3;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Breadth first search out from the goal counts. A move takes one
+//      tile from a line next to the blank's line into it, and the blank
+//      goes the other way. The tile can be any one that belongs in
+//      some 'goalLine' and is in that next line, so there is one move
+//      per goal line with a count above 0.
+//
+///////////////////////////////////////////////////////////////////////////////
+WalkingDistanceTable::WalkingDistanceTable(int goalBlankLine) : distance(WALKING_CODES, UNREACHED) {
+
+    // every tile in its own line, with one short in the blank's line
+    int goalCode = 0;
+    for(int line = 0; line < BOARD_DIM; line++) {
+        goalCode += (line == goalBlankLine ? BOARD_DIM - 1 : BOARD_DIM) * walkingCodeOf(line, line);
+    }
+
+    queue<int> open;
+    distance[goalCode] = 0;
+    open.push(goalCode);
+
+    while(!open.empty()) {
+
+        int code = open.front();
+        open.pop();
+
+        // the blank's line is the one with a tile missing
+        int blankLine = 0;
+        for(int line = 0; line < BOARD_DIM; line++) {
+            int tiles = 0;
+            for(int goalLine = 0; goalLine < BOARD_DIM; goalLine++) {
+                tiles += countIn(code, line, goalLine);
+            }
+            if(tiles < BOARD_DIM) {
+                blankLine = line;
+            }
+        }
+
+        for(int step = -1; step <= 1; step += 2) {
+            int from = blankLine + step;
+            if(from < 0 || from >= BOARD_DIM) {
+                continue;
+            }
+
+            for(int goalLine = 0; goalLine < BOARD_DIM; goalLine++) {
+                if(countIn(code, from, goalLine) == 0) {
+                    continue;
+                }
+
+                int next = code - walkingCodeOf(from, goalLine) + walkingCodeOf(blankLine, goalLine);
+                if(distance[next] == UNREACHED) {
+                    distance[next] = distance[code] + 1;
+                    open.push(next);
+                }
+            }
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+
+// Built on first use (thread safe in C++11), then only ever read
+const WalkingDistanceTable &walkingDistanceTable(int goalBlankLine) {
+
+    static const WalkingDistanceTable tables[BOARD_DIM] = {
+        WalkingDistanceTable(0), WalkingDistanceTable(1), WalkingDistanceTable(2)
+    };
+    return tables[goalBlankLine];
+}
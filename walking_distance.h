@@ -0,0 +1,52 @@
+#ifndef __WALKING_DISTANCE_H__
+#define __WALKING_DISTANCE_H__
+
+#include <vector>
+
+#include "board.h"
+
+using namespace std;
+
+
+const int WALKING_CODES = 1 << (2 * NUM_CELLS);     // 2 bits for each of the 3x3 counts
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Walking distance table. Looking only at rows, a board is reduced to how many tiles in
+//  each row belong in each goal row (a 3x3 table of counts). The fewest up/down moves that
+//  turn those counts into the goal's is found once by a breadth first search over every
+//  such table, and the same is done for columns with left/right moves. As a move is either
+//  up/down or left/right, the two distances add up to an admissible heuristic.
+//
+//  The code of a board is the sum of count[line][goalLine] << 2 * (3 * line + goalLine).
+//  The blank is not counted, so the line with only 2 tiles is where the blank is.
+//
+//  The table only depends on which line the goal's blank is in, and rows and columns work
+//  the same way, so there are just 3 tables, built the first time each is asked for.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+class WalkingDistanceTable {
+
+private:
+    vector<unsigned char> distance;     // moves to the goal counts, by code
+
+public:
+    explicit WalkingDistanceTable(int goalBlankLine);
+
+    int getDistance(int code) const {
+        return distance[code];
+    }
+};
+
+
+// Shared table for a goal with its blank in line 'goalBlankLine'
+const WalkingDistanceTable &walkingDistanceTable(int goalBlankLine);
+
+
+// Amount a tile in 'line' that belongs in 'goalLine' adds to a code
+inline int walkingCodeOf(int line, int goalLine) {
+    return 1 << (2 * (BOARD_DIM * line + goalLine));
+}
+
+#endif